@@ -0,0 +1,247 @@
+/**
+ * @file bench_main.cpp
+ * @brief On-target Microbenchmark Suite
+ *
+ * Built by the `bench` PlatformIO environment (the `esp32` app build
+ * excludes this file, the bench build excludes main.cpp). Runs each
+ * benchmark once at boot and emits machine-parseable result lines:
+ *
+ *   BENCH,<name>,<iterations>,<total_us>,<us_per_op>[,<kb_per_s>]
+ *
+ * so runs can be diffed between firmware versions. The SPI benchmarks
+ * expect a MISO-MOSI loopback jumper or a connected FPGA; the SD
+ * benchmarks generate their own synthetic tree under /bench_tree.
+ */
+
+#include <Arduino.h>
+#include <SD.h>
+#include "config.h"
+#include "osd_menu.h"
+#include "spi_fpga.h"
+#include "file_browser.h"
+#include "file_transfer.h"
+#include "image_cache.h"
+#include "perf_probe.h"
+
+// ============================================================================
+// Benchmark Harness
+// ============================================================================
+
+static uint8_t* s_scratch = nullptr;  // OSD_BUFFER_SIZE scratch buffer
+
+static void report(const char* name, uint32_t iterations,
+                   uint64_t totalUs, uint32_t bytesPerOp = 0) {
+    uint32_t usPerOp = iterations ? (uint32_t)(totalUs / iterations) : 0;
+    if (bytesPerOp > 0 && totalUs > 0) {
+        uint32_t kbPerS = (uint32_t)(((uint64_t)bytesPerOp * iterations *
+                                      1000000ULL) / totalUs / 1024);
+        Serial.printf("BENCH,%s,%lu,%llu,%lu,%lu\n", name,
+                      (unsigned long)iterations,
+                      (unsigned long long)totalUs,
+                      (unsigned long)usPerOp, (unsigned long)kbPerS);
+    } else {
+        Serial.printf("BENCH,%s,%lu,%llu,%lu\n", name,
+                      (unsigned long)iterations,
+                      (unsigned long long)totalUs,
+                      (unsigned long)usPerOp);
+    }
+}
+
+// ============================================================================
+// Rasterization Benchmarks
+// ============================================================================
+
+static bool s_benchToggle = false;
+
+static MenuItem s_benchItems[] = {
+    MENU_TOGGLE("Aspect Ratio", &s_benchToggle, "Wide", "Original"),
+    MENU_TOGGLE("Hardware Multiply", &s_benchToggle, "Yes", "No"),
+    MENU_SEPARATOR(),
+    MENU_TOGGLE("Variable Brightness", &s_benchToggle, "Yes", "No"),
+    MENU_TOGGLE("CRT Wait", &s_benchToggle, "Yes", "No"),
+    MENU_TOGGLE("Bench Entry Five", &s_benchToggle, "On", "Off"),
+    MENU_TOGGLE("Bench Entry Six", &s_benchToggle, "On", "Off"),
+};
+
+static MenuItem s_benchRoot = MENU_SUBMENU("Benchmark Menu", s_benchItems,
+    sizeof(s_benchItems) / sizeof(MenuItem));
+
+/**
+ * Full-menu render: exercises drawChar (aligned and shifted), rect
+ * fill and hline through the public render path.
+ */
+static void benchRender() {
+    // Static: the strip cache plus browser window make this ~6.5KB,
+    // far too big for the 8KB loopTask stack
+    static OSDMenu menu;
+    menu.begin(&s_benchRoot);
+    menu.setVisible(true);
+
+    const uint32_t kIters = 200;
+    uint64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < kIters; i++) {
+        menu.render(s_scratch);
+    }
+    report("render_full", kIters, esp_timer_get_time() - start);
+
+    // Selection-move partial redraw (the common interactive case)
+    uint64_t startDirty = esp_timer_get_time();
+    for (uint32_t i = 0; i < kIters; i++) {
+        menu.navigate((i & 1) ? NAV_UP : NAV_DOWN);
+        menu.renderDirty(s_scratch);
+    }
+    report("render_dirty", kIters, esp_timer_get_time() - startDirty);
+}
+
+// ============================================================================
+// SPI Transfer Benchmarks
+// ============================================================================
+
+/**
+ * sendCommand payload sweep: measures the framed control path at the
+ * chunk sizes the transfer pipeline actually uses.
+ */
+static void benchSpiChunks() {
+    static const size_t kSizes[] = { 64, 256, 1024, 4096 };
+
+    for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); s++) {
+        size_t len = kSizes[s];
+        const uint32_t kIters = 64;
+
+        char name[32];
+        snprintf(name, sizeof(name), "spi_cmd_%u", (unsigned)len);
+
+        uint64_t start = esp_timer_get_time();
+        for (uint32_t i = 0; i < kIters; i++) {
+            spiFpga.sendCommand(FILE_TX_DAT, s_scratch, len);
+        }
+        report(name, kIters, esp_timer_get_time() - start, len);
+    }
+
+    // Full-frame DMA path
+    const uint32_t kFrames = 64;
+    uint64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < kFrames; i++) {
+        spiFpga.sendOsdFrame(s_scratch);
+    }
+    report("spi_osd_frame", kFrames, esp_timer_get_time() - start,
+           OSD_BUFFER_SIZE);
+}
+
+// ============================================================================
+// SD / Directory Benchmarks
+// ============================================================================
+
+#define BENCH_TREE       "/bench_tree"
+#define BENCH_TREE_FILES 64
+
+static void makeSyntheticTree() {
+    if (SD.exists(BENCH_TREE)) {
+        return;  // Reuse across runs; delete manually to regenerate
+    }
+
+    SD.mkdir(BENCH_TREE);
+    for (int i = 0; i < BENCH_TREE_FILES; i++) {
+        char path[48];
+        snprintf(path, sizeof(path), BENCH_TREE "/file_%03d.rim", i);
+        File f = SD.open(path, FILE_WRITE);
+        if (f) {
+            f.write(s_scratch, 256);
+            f.close();
+        }
+    }
+}
+
+static void benchDirScan() {
+    makeSyntheticTree();
+
+    const uint32_t kIters = 10;
+    uint64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < kIters; i++) {
+        // Invalidate so every iteration pays the full card scan
+        fileBrowser.invalidateCache(BENCH_TREE "/");
+        fileBrowser.setDirectory(BENCH_TREE "/");
+    }
+    report("dir_scan_cold", kIters, esp_timer_get_time() - start);
+
+    // Cached path (RAM or index hit)
+    uint64_t startWarm = esp_timer_get_time();
+    for (uint32_t i = 0; i < kIters; i++) {
+        fileBrowser.setDirectory(BENCH_TREE "/");
+    }
+    report("dir_scan_warm", kIters, esp_timer_get_time() - startWarm);
+}
+
+// ============================================================================
+// End-to-end Transfer Benchmark
+// ============================================================================
+
+#define BENCH_XFER_FILE  BENCH_TREE "/xfer_64k.bin"
+#define BENCH_XFER_SIZE  (64 * 1024)
+
+static void benchTransfer() {
+    if (!SD.exists(BENCH_XFER_FILE)) {
+        File f = SD.open(BENCH_XFER_FILE, FILE_WRITE);
+        if (!f) {
+            Serial.println("BENCH,transfer_e2e,SKIP");
+            return;
+        }
+        for (size_t off = 0; off < BENCH_XFER_SIZE; off += OSD_BUFFER_SIZE) {
+            f.write(s_scratch, OSD_BUFFER_SIZE);
+        }
+        f.close();
+    }
+
+    // First run streams from SD, second from the image cache
+    const char* names[] = { "transfer_sd", "transfer_cached" };
+    for (int run = 0; run < 2; run++) {
+        uint64_t start = esp_timer_get_time();
+        if (!fileTransfer.startTransfer(BENCH_XFER_FILE, FILE_TYPE_BIN)) {
+            Serial.printf("BENCH,%s,SKIP\n", names[run]);
+            continue;
+        }
+        while (fileTransfer.isActive()) {
+            delay(1);
+        }
+        report(names[run], 1, esp_timer_get_time() - start,
+               BENCH_XFER_SIZE);
+    }
+}
+
+// ============================================================================
+// Entry
+// ============================================================================
+
+void setup() {
+    Serial.begin(115200);
+    delay(500);
+    Serial.println("\nBENCH,begin");
+
+    s_scratch = (uint8_t*)malloc(OSD_BUFFER_SIZE);
+    for (size_t i = 0; i < OSD_BUFFER_SIZE; i++) {
+        s_scratch[i] = (uint8_t)(i * 31);
+    }
+
+    bool spiOk = spiFpga.init();
+    bool sdOk = fileBrowser.init();
+    imageCache.init();
+    fileTransfer.init();
+
+    benchRender();
+
+    if (spiOk) {
+        benchSpiChunks();
+    }
+    if (sdOk) {
+        benchDirScan();
+        if (spiOk) {
+            benchTransfer();
+        }
+    }
+
+    Serial.println("BENCH,end");
+}
+
+void loop() {
+    delay(1000);
+}
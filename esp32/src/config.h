@@ -25,6 +25,12 @@
 #define PIN_OSD_IRQ      16    // OSD interrupt request from FPGA
 #define PIN_ESP_READY    4     // ESP32 ready signal to FPGA
 
+// ============================================================================
+// SD Card
+// ============================================================================
+
+#define SD_CS_PIN        13    // microSD chip select (ULX3S SD_D3)
+
 // ============================================================================
 // SPI Configuration
 // ============================================================================
@@ -39,6 +45,11 @@
 #define OSD_HEIGHT       128   // OSD buffer height in pixels
 #define OSD_BUFFER_SIZE  (OSD_WIDTH * OSD_HEIGHT / 8)  // 1-bit per pixel
 
+// OSD transfer lines (matches OSD_CMD_WRITE 0x20-0x2F command space)
+#define OSD_LINES        16    // Number of addressable OSD lines
+#define OSD_LINE_HEIGHT  (OSD_HEIGHT / OSD_LINES)      // Pixel rows per line
+#define OSD_LINE_BYTES   (OSD_WIDTH * OSD_LINE_HEIGHT / 8)  // Bytes per line
+
 // ============================================================================
 // Menu Configuration
 // ============================================================================
@@ -55,4 +66,15 @@
 #define MENU_REPEAT_MS       100   // Key repeat interval
 #define MENU_TIMEOUT_MS      30000 // Auto-hide timeout (30 seconds)
 
+// ============================================================================
+// Core Status Word Bits
+// ============================================================================
+
+// Bit positions in the 32-bit status word sent via STATUS_SET
+// (bit 0 is reserved for core reset)
+#define STATUS_BIT_ASPECT_WIDE     1   // Wide aspect ratio
+#define STATUS_BIT_HW_MULTIPLY     2   // Hardware multiply/divide
+#define STATUS_BIT_VAR_BRIGHTNESS  3   // Variable CRT brightness
+#define STATUS_BIT_CRT_WAIT        4   // CRT wait states
+
 #endif // CONFIG_H
@@ -1,19 +1,172 @@
 /**
  * file_browser.cpp - SD Card File Browser Implementation
  *
- * Provides directory navigation and file listing with extension filtering
- * for PDP-1 ROM/RIM file loading.
+ * Provides directory navigation and file listing with extension
+ * filtering for PDP-1 ROM/RIM file loading. Directory listings are
+ * cached both in RAM (LRU over the last few directories) and on the
+ * card itself as per-directory index files, so only the first visit
+ * to a directory pays the cost of a full openNextFile() walk.
+ *
+ * Entry storage is all static slabs: the resident listing, the
+ * filtered index view, the window pool, and a shared RAM-cache arena
+ * that slots borrow contiguous runs from. Heap traffic is confined to
+ * the one-time index build of an oversized directory.
  */
 
 #include "file_browser.h"
+#include "ring_log.h"
 #include "config.h"
+#include <Arduino.h>
 #include <SD.h>
 #include <string.h>
 #include <algorithm>
+#include <esp_heap_caps.h>
 
 // Global instance
 FileBrowser fileBrowser;
 
+// Synthetic parent entry, shared by every non-root listing
+static const FileEntry kParentEntry = { "..", "..", 0, true };
+
+// ============================================================================
+// Directory Index Cache
+// ============================================================================
+// On-SD format: header followed by raw sorted FileEntry records. The
+// parent ".." entry is never stored; it is synthesized by applyFilter.
+// The header's mtime ties the index to the directory contents at the
+// time it was written.
+// ============================================================================
+
+#define INDEX_FILENAME  ".fpg1.idx"
+#define INDEX_MAGIC     0x58444946  // "FIDX"
+#define INDEX_VERSION   2           // v2: FileEntry carries sortKey
+
+struct IndexHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    uint32_t entryCount;
+    uint32_t dirMtime;
+};
+
+// ============================================================================
+// RAM Cache Arena
+// ============================================================================
+// Recent unfiltered listings live in one fixed arena; each cache slot
+// borrows a contiguous run of it. Storing a listing evicts LRU slots
+// until the run fits and compacts the survivors, so the cache never
+// touches the heap and never fragments it.
+// ============================================================================
+
+#define DIR_CACHE_ARENA_ENTRIES \
+    (FileBrowser::RESIDENT_MAX_ENTRIES + FileBrowser::RESIDENT_MAX_ENTRIES / 2)
+
+struct DirCacheSlot {
+    char path[256];
+    uint16_t offset;    // First arena entry of this listing
+    uint16_t count;
+    uint32_t lastUsed;
+    bool valid;
+};
+
+static FileEntry s_cacheArena[DIR_CACHE_ARENA_ENTRIES];
+static DirCacheSlot s_dirCache[FileBrowser::DIR_CACHE_SLOTS];
+static uint32_t s_cacheClock = 0;
+
+static size_t cacheUsedEntries() {
+    size_t used = 0;
+    for (size_t i = 0; i < FileBrowser::DIR_CACHE_SLOTS; i++) {
+        if (s_dirCache[i].valid) {
+            used += s_dirCache[i].count;
+        }
+    }
+    return used;
+}
+
+// Squeeze valid runs to the front of the arena (slot order by offset),
+// leaving all free space as one tail run
+static void cacheCompact() {
+    size_t write = 0;
+
+    while (true) {
+        // Next valid slot by arena offset at or beyond the write head
+        DirCacheSlot* next = nullptr;
+        for (size_t i = 0; i < FileBrowser::DIR_CACHE_SLOTS; i++) {
+            DirCacheSlot& s = s_dirCache[i];
+            if (s.valid && s.offset >= write &&
+                (!next || s.offset < next->offset)) {
+                next = &s;
+            }
+        }
+        if (!next) {
+            break;
+        }
+
+        if (next->offset != write) {
+            memmove(&s_cacheArena[write], &s_cacheArena[next->offset],
+                    next->count * sizeof(FileEntry));
+            next->offset = (uint16_t)write;
+        }
+        write += next->count;
+    }
+}
+
+static void buildIndexPath(char* out, size_t outSize, const char* dirPath) {
+    // dirPath always carries a trailing slash
+    snprintf(out, outSize, "%s" INDEX_FILENAME, dirPath);
+}
+
+// Pack up to 4 extension characters into one uppercase code; longer
+// extensions never match (ours are 3-4 chars: PDP, RIM, BIN, HEX)
+static uint32_t packExtCode(const char* ext, size_t len) {
+    if (len == 0 || len > 4) {
+        return 0;
+    }
+
+    uint32_t code = 0;
+    for (size_t i = 0; i < len; i++) {
+        code = (code << 8) | (uint8_t)toupper(ext[i]);
+    }
+    return code;
+}
+
+// Sort order shared by the resident and oversized scan paths:
+// directories first, then alphabetically on the case-folded key
+static bool entryLess(const FileEntry& a, const FileEntry& b) {
+    if (a.isDirectory != b.isDirectory) {
+        return a.isDirectory;
+    }
+    return strcmp(a.sortKey, b.sortKey) < 0;
+}
+
+// Fill a FileEntry from an open directory child; false for entries
+// the browser hides (dotfiles, including our own index files)
+static bool fillEntry(File& child, FileEntry& fe) {
+    const char* name = child.name();
+    const char* lastSlash = strrchr(name, '/');
+    if (lastSlash) {
+        name = lastSlash + 1;
+    }
+
+    if (name[0] == '.') {
+        return false;
+    }
+
+    strncpy(fe.name, name, sizeof(fe.name) - 1);
+    fe.name[sizeof(fe.name) - 1] = '\0';
+    fe.size = child.size();
+    fe.isDirectory = child.isDirectory();
+
+    // Case-fold once here so sorting never calls strcasecmp
+    for (size_t i = 0; i < sizeof(fe.sortKey); i++) {
+        fe.sortKey[i] = toupper(fe.name[i]);
+        if (!fe.name[i]) break;
+    }
+    fe.sortKey[sizeof(fe.sortKey) - 1] = '\0';
+
+    return true;
+}
+
 bool FileBrowser::init() {
     // Initialize SD card
     if (!SD.begin(SD_CS_PIN)) {
@@ -25,7 +178,7 @@ bool FileBrowser::init() {
 
     // Set root directory
     strcpy(currentPath, "/");
-    filter[0] = '\0';
+    filterCodeCount = 0;
 
     // Initial scan
     scanDirectory();
@@ -70,27 +223,80 @@ bool FileBrowser::setDirectory(const char* path) {
 }
 
 void FileBrowser::setFilter(const char* extensions) {
+    // Parse the comma list once into packed uppercase codes
+    filterCodeCount = 0;
+
     if (extensions) {
-        strncpy(filter, extensions, sizeof(filter) - 1);
-        filter[sizeof(filter) - 1] = '\0';
-        // Convert to uppercase for case-insensitive matching
-        for (char* p = filter; *p; p++) {
-            *p = toupper(*p);
+        const char* p = extensions;
+        while (*p && filterCodeCount < MAX_FILTER_EXTS) {
+            // Trim leading whitespace
+            while (*p == ' ' || *p == ',') p++;
+            if (!*p) break;
+
+            const char* start = p;
+            while (*p && *p != ',') p++;
+            size_t len = p - start;
+
+            // Trim trailing whitespace
+            while (len > 0 && start[len - 1] == ' ') len--;
+
+            uint32_t code = packExtCode(start, len);
+            if (code != 0) {
+                filterCodes[filterCodeCount++] = code;
+            }
         }
-    } else {
-        filter[0] = '\0';
     }
 
-    // Re-scan with new filter
-    scanDirectory();
+    // Re-derive the filtered view from the cached listing; no rescan
+    filteredCountValid = false;
+    applyFilter();
 }
 
+// ============================================================================
+// Listing Acquisition (RAM cache -> index file -> full scan)
+// ============================================================================
+
 void FileBrowser::scanDirectory() {
-    entries.clear();
+    windowedMode = false;
+    filteredCountValid = false;
+
+    if (loadFromRamCache()) {
+        applyFilter();
+        return;
+    }
+
+    // Directory mtime validates the on-SD index
+    uint32_t dirMtime = 0;
+    File dir = SD.open(currentPath);
+    if (dir) {
+        dirMtime = (uint32_t)dir.getLastWrite();
+        dir.close();
+    }
+
+    bool haveListing = loadIndexFile(dirMtime);
+    if (!haveListing && !windowedMode) {
+        rescanFromCard(dirMtime);
+    }
+
+    // Huge directories are not kept resident: serve windows from the
+    // sorted index file instead, so memory stays O(window)
+    if (windowedMode) {
+        listingCount = 0;
+        filteredViewCount = 0;
+        return;
+    }
+
+    storeToRamCache();
+    applyFilter();
+}
+
+void FileBrowser::rescanFromCard(uint32_t dirMtime) {
+    listingCount = 0;
+    size_t totalCount = 0;
 
     File dir = SD.open(currentPath);
     if (!dir) {
-        Serial.printf("Failed to open directory: %s\n", currentPath);
+        ringLog.write("FS", "Failed to open directory: %s", currentPath);
         return;
     }
 
@@ -99,69 +305,375 @@ void FileBrowser::scanDirectory() {
         return;
     }
 
-    // Add parent directory entry if not at root
-    if (strcmp(currentPath, "/") != 0) {
-        FileEntry parent;
-        strcpy(parent.name, "..");
-        parent.size = 0;
-        parent.isDirectory = true;
-        entries.push_back(parent);
-    }
-
-    // Scan all entries
+    // Scan into the resident slab; past its capacity keep counting so
+    // the oversized pass knows how much scratch to reserve
     File entry = dir.openNextFile();
     while (entry) {
         FileEntry fe;
-
-        // Get filename (skip path)
-        const char* name = entry.name();
-        const char* lastSlash = strrchr(name, '/');
-        if (lastSlash) {
-            name = lastSlash + 1;
+        if (fillEntry(entry, fe)) {
+            if (totalCount < RESIDENT_MAX_ENTRIES) {
+                listing[totalCount] = fe;
+            }
+            totalCount++;
         }
+        entry = dir.openNextFile();
+    }
+
+    dir.close();
 
-        // Skip hidden files
-        if (name[0] == '.') {
+    if (totalCount > RESIDENT_MAX_ENTRIES) {
+        rescanOversized(dirMtime, totalCount);
+        return;
+    }
+
+    listingCount = totalCount;
+
+    // Sort once at scan time: directories first, then alphabetically.
+    // Cached copies (RAM and index file) stay sorted.
+    std::sort(listing, listing + listingCount, entryLess);
+
+    writeIndexFile(listing, listingCount, dirMtime);
+
+    ringLog.write("FS", "Scanned %s: %d entries", currentPath,
+                 (int)listingCount);
+}
+
+/**
+ * One-time index build for a directory too large to keep resident.
+ * The full listing is sorted in heap scratch (preferably SPIRAM),
+ * written to the index file, and the scratch freed immediately; all
+ * later visits stream windows from the index with no allocation.
+ */
+void FileBrowser::rescanOversized(uint32_t dirMtime, size_t totalCount) {
+    size_t bytes = totalCount * sizeof(FileEntry);
+    FileEntry* scratch =
+        (FileEntry*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+    if (!scratch) {
+        scratch = (FileEntry*)heap_caps_malloc(bytes, MALLOC_CAP_8BIT);
+    }
+    if (!scratch) {
+        // Can't sort the full listing: fall back to the truncated
+        // resident slab so the browser still shows something
+        ringLog.write("FS", "Oversized dir %s: scratch alloc failed",
+                      currentPath);
+        listingCount = RESIDENT_MAX_ENTRIES;
+        std::sort(listing, listing + listingCount, entryLess);
+        return;
+    }
+
+    size_t count = 0;
+    File dir = SD.open(currentPath);
+    if (dir) {
+        File entry = dir.openNextFile();
+        while (entry && count < totalCount) {
+            if (fillEntry(entry, scratch[count])) {
+                count++;
+            }
             entry = dir.openNextFile();
+        }
+        dir.close();
+    }
+
+    std::sort(scratch, scratch + count, entryLess);
+    writeIndexFile(scratch, count, dirMtime);
+    heap_caps_free(scratch);
+
+    windowedMode = true;
+
+    ringLog.write("FS", "Indexed %s: %d entries (windowed)", currentPath,
+                  (int)count);
+}
+
+// ============================================================================
+// RAM Cache
+// ============================================================================
+
+bool FileBrowser::loadFromRamCache() {
+    for (size_t i = 0; i < DIR_CACHE_SLOTS; i++) {
+        DirCacheSlot& s = s_dirCache[i];
+        if (s.valid && strcmp(s.path, currentPath) == 0) {
+            memcpy(listing, &s_cacheArena[s.offset],
+                   s.count * sizeof(FileEntry));
+            listingCount = s.count;
+            s.lastUsed = ++s_cacheClock;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FileBrowser::storeToRamCache() {
+    if (listingCount > DIR_CACHE_ARENA_ENTRIES) {
+        return;  // Cannot happen: slab is smaller than the arena
+    }
+
+    // Pick the least recently used slot (free slots first)
+    DirCacheSlot* slot = &s_dirCache[0];
+    for (size_t i = 1; i < DIR_CACHE_SLOTS; i++) {
+        DirCacheSlot& s = s_dirCache[i];
+        if (!s.valid) {
+            slot = &s;
+            break;
+        }
+        if (slot->valid && s.lastUsed < slot->lastUsed) {
+            slot = &s;
+        }
+    }
+    slot->valid = false;
+
+    // Evict LRU slots until the listing's run fits the arena
+    while (DIR_CACHE_ARENA_ENTRIES - cacheUsedEntries() < listingCount) {
+        DirCacheSlot* lru = nullptr;
+        for (size_t i = 0; i < DIR_CACHE_SLOTS; i++) {
+            DirCacheSlot& s = s_dirCache[i];
+            if (s.valid && (!lru || s.lastUsed < lru->lastUsed)) {
+                lru = &s;
+            }
+        }
+        if (!lru) {
+            return;  // Arena smaller than the listing; skip caching
+        }
+        lru->valid = false;
+    }
+
+    // Compact survivors so the free space is one contiguous tail run
+    cacheCompact();
+    size_t tail = cacheUsedEntries();
+
+    memcpy(&s_cacheArena[tail], listing, listingCount * sizeof(FileEntry));
+    strcpy(slot->path, currentPath);
+    slot->offset = (uint16_t)tail;
+    slot->count = (uint16_t)listingCount;
+    slot->lastUsed = ++s_cacheClock;
+    slot->valid = true;
+}
+
+// ============================================================================
+// On-SD Index Files
+// ============================================================================
+
+bool FileBrowser::loadIndexFile(uint32_t dirMtime) {
+    char idxPath[280];
+    buildIndexPath(idxPath, sizeof(idxPath), currentPath);
+
+    File idx = SD.open(idxPath, FILE_READ);
+    if (!idx) {
+        return false;
+    }
+
+    IndexHeader header;
+    if (idx.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+        header.magic != INDEX_MAGIC ||
+        header.version != INDEX_VERSION ||
+        header.dirMtime != dirMtime) {
+        idx.close();
+        return false;
+    }
+
+    // Oversized listings never come resident: the valid index itself
+    // is the backing store for windowed access
+    if (header.entryCount > RESIDENT_MAX_ENTRIES) {
+        idx.close();
+        windowedMode = true;
+        return true;
+    }
+
+    size_t want = header.entryCount * sizeof(FileEntry);
+    size_t got = idx.read((uint8_t*)listing, want);
+    idx.close();
+
+    if (got != want) {
+        listingCount = 0;
+        return false;
+    }
+
+    listingCount = header.entryCount;
+    return true;
+}
+
+void FileBrowser::writeIndexFile(const FileEntry* list, size_t count,
+                                 uint32_t dirMtime) {
+    char idxPath[280];
+    buildIndexPath(idxPath, sizeof(idxPath), currentPath);
+
+    File idx = SD.open(idxPath, FILE_WRITE);
+    if (!idx) {
+        // Read-only card or full: caching is best-effort
+        return;
+    }
+
+    IndexHeader header;
+    header.magic = INDEX_MAGIC;
+    header.version = INDEX_VERSION;
+    header.reserved = 0;
+    header.entryCount = count;
+    header.dirMtime = dirMtime;
+
+    idx.write((const uint8_t*)&header, sizeof(header));
+    idx.write((const uint8_t*)list, count * sizeof(FileEntry));
+    idx.close();
+}
+
+void FileBrowser::invalidateCache(const char* path) {
+    for (size_t i = 0; i < DIR_CACHE_SLOTS; i++) {
+        if (s_dirCache[i].valid &&
+            (!path || strcmp(s_dirCache[i].path, path) == 0)) {
+            // Arena run is reclaimed by compaction on the next store
+            s_dirCache[i].valid = false;
+        }
+    }
+
+    if (path) {
+        char idxPath[280];
+        buildIndexPath(idxPath, sizeof(idxPath), path);
+        SD.remove(idxPath);
+    }
+}
+
+// ============================================================================
+// Windowed Listing
+// ============================================================================
+
+// Fixed window pool: scanWindow() results live here, no heap involved
+static FileEntry s_window[FileBrowser::WINDOW_CAPACITY];
+
+/**
+ * Stream the sorted on-SD index, applying the extension filter, and
+ * collect up to count filtered entries starting at offset. Entry 0 is
+ * the synthesized ".." parent when not at root. Also reports the total
+ * filtered count when totalOut is non-null (requires a full pass).
+ */
+size_t FileBrowser::streamWindow(size_t offset, size_t count,
+                                 FileEntry* out, size_t* totalOut) {
+    char idxPath[280];
+    buildIndexPath(idxPath, sizeof(idxPath), currentPath);
+
+    File idx = SD.open(idxPath, FILE_READ);
+    if (!idx) {
+        if (totalOut) *totalOut = 0;
+        return 0;
+    }
+
+    IndexHeader header;
+    if (idx.read((uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+        header.magic != INDEX_MAGIC || header.version != INDEX_VERSION) {
+        idx.close();
+        if (totalOut) *totalOut = 0;
+        return 0;
+    }
+
+    size_t filteredIdx = 0;
+    size_t filled = 0;
+
+    // Parent entry counts as filtered index 0 outside root
+    if (strcmp(currentPath, "/") != 0) {
+        if (filteredIdx >= offset && filled < count) {
+            out[filled] = kParentEntry;
+            filled++;
+        }
+        filteredIdx++;
+    }
+
+    FileEntry fe;
+    for (uint32_t i = 0; i < header.entryCount; i++) {
+        if (idx.read((uint8_t*)&fe, sizeof(fe)) != sizeof(fe)) {
+            break;
+        }
+
+        if (!fe.isDirectory && !matchesFilter(fe.name)) {
             continue;
         }
 
-        strncpy(fe.name, name, sizeof(fe.name) - 1);
-        fe.name[sizeof(fe.name) - 1] = '\0';
-        fe.size = entry.size();
-        fe.isDirectory = entry.isDirectory();
+        if (filteredIdx >= offset && filled < count) {
+            out[filled] = fe;
+            filled++;
+        }
+        filteredIdx++;
 
-        // Apply filter (directories always pass)
-        if (fe.isDirectory || matchesFilter(fe.name)) {
-            entries.push_back(fe);
+        // Without a count request we can stop once the window is full
+        if (!totalOut && filled == count) {
+            break;
         }
+    }
 
-        entry = dir.openNextFile();
+    idx.close();
+
+    if (totalOut) {
+        *totalOut = filteredIdx;
     }
+    return filled;
+}
 
-    dir.close();
+size_t FileBrowser::scanWindow(size_t offset, size_t count,
+                               const FileEntry** outEntries) {
+    if (count > WINDOW_CAPACITY) {
+        count = WINDOW_CAPACITY;
+    }
+    *outEntries = s_window;
+
+    if (!windowedMode) {
+        // Resident listing: copy the slice out of the filtered view
+        size_t filled = 0;
+        const FileEntry* fe;
+        while (filled < count && (fe = residentEntry(offset + filled))) {
+            s_window[filled] = *fe;
+            filled++;
+        }
+        return filled;
+    }
 
-    // Sort entries: directories first, then alphabetically
-    std::sort(entries.begin(), entries.end(), [](const FileEntry& a, const FileEntry& b) {
-        // Parent directory always first
-        if (strcmp(a.name, "..") == 0) return true;
-        if (strcmp(b.name, "..") == 0) return false;
+    return streamWindow(offset, count, s_window, nullptr);
+}
 
-        // Directories before files
-        if (a.isDirectory != b.isDirectory) {
-            return a.isDirectory;
+size_t FileBrowser::getTotalCount() {
+    if (!windowedMode) {
+        return filteredViewCount + (hasParentEntry ? 1 : 0);
+    }
+
+    if (!filteredCountValid) {
+        streamWindow(0, 0, s_window, &filteredCount);
+        filteredCountValid = true;
+    }
+    return filteredCount;
+}
+
+// ============================================================================
+// Filtered View
+// ============================================================================
+
+void FileBrowser::applyFilter() {
+    filteredViewCount = 0;
+
+    // Synthesize parent directory entry if not at root
+    hasParentEntry = (strcmp(currentPath, "/") != 0);
+
+    for (size_t i = 0; i < listingCount; i++) {
+        // Directories always pass the filter
+        if (listing[i].isDirectory || matchesFilter(listing[i].name)) {
+            filteredView[filteredViewCount++] = (uint16_t)i;
         }
+    }
+}
 
-        // Alphabetical order (case-insensitive)
-        return strcasecmp(a.name, b.name) < 0;
-    });
+// Resolve a filtered index against the resident listing; index 0 is
+// the synthetic parent outside root
+const FileEntry* FileBrowser::residentEntry(size_t index) {
+    if (hasParentEntry) {
+        if (index == 0) {
+            return &kParentEntry;
+        }
+        index--;
+    }
 
-    Serial.printf("Scanned %s: %d entries\n", currentPath, entries.size());
+    if (index >= filteredViewCount) {
+        return nullptr;
+    }
+    return &listing[filteredView[index]];
 }
 
 bool FileBrowser::matchesFilter(const char* filename) {
     // No filter = match all
-    if (filter[0] == '\0') {
+    if (filterCodeCount == 0) {
         return true;
     }
 
@@ -171,38 +683,27 @@ bool FileBrowser::matchesFilter(const char* filename) {
         return false;  // No extension
     }
 
-    // Extract extension (uppercase)
-    char ext[16];
-    strncpy(ext, dot + 1, sizeof(ext) - 1);
-    ext[sizeof(ext) - 1] = '\0';
-    for (char* p = ext; *p; p++) {
-        *p = toupper(*p);
+    // Single packed compare per filter entry
+    uint32_t code = packExtCode(dot + 1, strlen(dot + 1));
+    if (code == 0) {
+        return false;
     }
 
-    // Check against filter list (comma-separated)
-    char filterCopy[32];
-    strcpy(filterCopy, filter);
-
-    char* token = strtok(filterCopy, ",");
-    while (token) {
-        // Trim whitespace
-        while (*token == ' ') token++;
-
-        if (strcmp(ext, token) == 0) {
+    for (uint8_t i = 0; i < filterCodeCount; i++) {
+        if (filterCodes[i] == code) {
             return true;
         }
-        token = strtok(NULL, ",");
     }
 
     return false;
 }
 
-const std::vector<FileEntry>& FileBrowser::getEntries() {
-    return entries;
-}
+// ============================================================================
+// Navigation
+// ============================================================================
 
 size_t FileBrowser::getEntryCount() {
-    return entries.size();
+    return getTotalCount();
 }
 
 bool FileBrowser::navigateUp() {
@@ -225,6 +726,12 @@ bool FileBrowser::navigateUp() {
             currentPath[1] = '\0';
         } else {
             *lastSlash = '\0';
+            // Restore trailing slash convention
+            size_t newLen = strlen(currentPath);
+            if (newLen < sizeof(currentPath) - 1) {
+                currentPath[newLen] = '/';
+                currentPath[newLen + 1] = '\0';
+            }
         }
     }
 
@@ -233,27 +740,26 @@ bool FileBrowser::navigateUp() {
 }
 
 bool FileBrowser::navigateInto(size_t index) {
-    if (index >= entries.size()) {
+    const FileEntry* entry = getEntry(index);
+    if (!entry) {
         return false;
     }
 
-    const FileEntry& entry = entries[index];
-
-    if (!entry.isDirectory) {
+    if (!entry->isDirectory) {
         return false;  // Can't navigate into file
     }
 
     // Handle parent directory
-    if (strcmp(entry.name, "..") == 0) {
+    if (strcmp(entry->name, "..") == 0) {
         return navigateUp();
     }
 
     // Build new path
     char newPath[256];
     if (strcmp(currentPath, "/") == 0) {
-        snprintf(newPath, sizeof(newPath), "/%s", entry.name);
+        snprintf(newPath, sizeof(newPath), "/%s", entry->name);
     } else {
-        snprintf(newPath, sizeof(newPath), "%s/%s", currentPath, entry.name);
+        snprintf(newPath, sizeof(newPath), "%s%s", currentPath, entry->name);
     }
 
     return setDirectory(newPath);
@@ -264,8 +770,13 @@ const char* FileBrowser::getCurrentPath() {
 }
 
 const FileEntry* FileBrowser::getEntry(size_t index) {
-    if (index >= entries.size()) {
-        return nullptr;
+    if (windowedMode) {
+        const FileEntry* window = nullptr;
+        if (scanWindow(index, 1, &window) != 1) {
+            return nullptr;
+        }
+        return window;
     }
-    return &entries[index];
+
+    return residentEntry(index);
 }
@@ -1,31 +1,117 @@
 #pragma once
-#include <vector>
-#include <string>
 #include <stdint.h>
+#include <stddef.h>
 
 struct FileEntry {
     char name[32];
+    char sortKey[32];   // Case-folded name, computed once at scan time
     uint32_t size;
     bool isDirectory;
 };
 
+/**
+ * SD card file browser with cached directory listings.
+ *
+ * Each scanned directory is persisted to an on-SD index file
+ * (.fpg1.idx, invalidated by directory mtime) so revisits load with
+ * one sequential read instead of walking openNextFile(), and the last
+ * few listings are additionally kept in RAM so bouncing between two
+ * folders is instant. Filter changes re-derive the filtered view from
+ * the cached unfiltered listing and never rescan the card.
+ *
+ * All entry storage is static: the resident listing lives in a fixed
+ * slab, the filtered view is an index array over it, and the RAM
+ * cache borrows runs from a shared fixed arena. Steady-state browsing
+ * performs no heap allocations, so it cannot fragment the internal
+ * heap that DMA-capable buffers are carved from.
+ */
 class FileBrowser {
 public:
     bool init();
     bool setDirectory(const char* path);
     void setFilter(const char* extensions);  // "PDP,RIM,BIN"
-    const std::vector<FileEntry>& getEntries();
     bool navigateUp();
     bool navigateInto(size_t index);
     const char* getCurrentPath();
     const FileEntry* getEntry(size_t index);
     size_t getEntryCount();
 
+    /**
+     * Drop cached listings (RAM and on-SD index) for one directory,
+     * or for everything when path is null. Call after writing files.
+     */
+    void invalidateCache(const char* path = nullptr);
+
+    /**
+     * Fetch a window of the filtered listing into a static pool.
+     *
+     * For directories above the residency threshold the window is
+     * streamed from the sorted on-SD index, so memory use is
+     * O(WINDOW_CAPACITY) no matter how large the directory is. The
+     * returned pointers stay valid until the next scanWindow() call.
+     *
+     * @param offset First filtered entry index to fetch
+     * @param count Entries requested (capped to WINDOW_CAPACITY)
+     * @param outEntries Receives pointer to the window pool
+     * @return Number of entries actually fetched
+     */
+    size_t scanWindow(size_t offset, size_t count, const FileEntry** outEntries);
+
+    /**
+     * @brief Total filtered entry count (streamed and cached for
+     *        windowed directories)
+     */
+    size_t getTotalCount();
+
+    /** @brief True when the listing is served from the on-SD index */
+    bool isWindowed() const { return windowedMode; }
+
+    // Number of directory listings kept in RAM (LRU)
+    static const size_t DIR_CACHE_SLOTS = 4;
+
+    // Entries per fetched window (OSD shows ~10 rows)
+    static const size_t WINDOW_CAPACITY = 16;
+
+    // Listings larger than this are not kept resident in RAM
+    static const size_t RESIDENT_MAX_ENTRIES = 256;
+
+    // Maximum extensions in a filter list
+    static const size_t MAX_FILTER_EXTS = 8;
+
 private:
     char currentPath[256];
-    char filter[32];
-    std::vector<FileEntry> entries;
+
+    // Filter precompiled into packed uppercase extension codes: one
+    // 4-byte integer compare per file instead of strtok/toupper work
+    uint32_t filterCodes[MAX_FILTER_EXTS];
+    uint8_t filterCodeCount = 0;
+
+    // Resident unfiltered listing: fixed slab, sorted at scan time
+    FileEntry listing[RESIDENT_MAX_ENTRIES];
+    size_t listingCount = 0;
+
+    // Filtered view: indices into the listing slab instead of entry
+    // copies; the synthetic ".." parent is prepended logically
+    uint16_t filteredView[RESIDENT_MAX_ENTRIES];
+    size_t filteredViewCount = 0;
+    bool hasParentEntry = false;
+
+    bool windowedMode = false;          // Listing served from index file
+    size_t filteredCount = 0;           // Cached count in windowed mode
+    bool filteredCountValid = false;
+
     void scanDirectory();
+    size_t streamWindow(size_t offset, size_t count, FileEntry* out,
+                        size_t* totalOut);
+    void rescanFromCard(uint32_t dirMtime);
+    void rescanOversized(uint32_t dirMtime, size_t totalCount);
+    void applyFilter();
+    const FileEntry* residentEntry(size_t index);
+    bool loadFromRamCache();
+    void storeToRamCache();
+    bool loadIndexFile(uint32_t dirMtime);
+    void writeIndexFile(const FileEntry* list, size_t count,
+                        uint32_t dirMtime);
     bool matchesFilter(const char* filename);
 };
 
@@ -1,14 +1,28 @@
 /**
  * file_transfer.cpp - ROM/RIM File Transfer to FPGA
  *
- * Handles file loading from SD card to FPGA memory with IRQ signaling.
- * Supports PDP/ROM, RIM, and BIN file formats.
+ * Streams files from SD card to FPGA memory through the SPIFpga DMA
+ * driver. A dedicated task double-buffers the pipeline: the SD read of
+ * chunk N+1 overlaps the DMA transmission of chunk N.
+ * Supports PDP/ROM, RIM, and BIN file formats; RIM tapes are decoded
+ * to packed 18-bit words on this side before transfer.
  */
 
 #include "file_transfer.h"
 #include "config.h"
+#include "spi_fpga.h"
+#include "image_cache.h"
+#include "rim_decoder.h"
+#include "settings.h"
+#include "ring_log.h"
+#include "perf_probe.h"
+#include <Arduino.h>
 #include <SD.h>
-#include <SPI.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
 #include <string.h>
 
 // Global instance
@@ -19,223 +33,623 @@ FileTransfer fileTransfer;
 #define CMD_TRANSFER_DATA       0x81
 #define CMD_TRANSFER_END        0x82
 #define CMD_TRANSFER_ABORT      0x83
+#define CMD_TRANSFER_CRC        0x84
 
-// IOCTL register addresses (directly matching FPGA memory map)
-#define IOCTL_ADDR_COMMAND      0x00
-#define IOCTL_ADDR_FILE_TYPE    0x01
-#define IOCTL_ADDR_SIZE_LOW     0x02
-#define IOCTL_ADDR_SIZE_HIGH    0x03
-#define IOCTL_ADDR_DATA         0x04
-#define IOCTL_ADDR_STATUS       0x05
+// Framed chunk layout: [cmd][len_lo][len_hi][data...]
+#define CHUNK_HEADER_SIZE       3
 
-bool FileTransfer::startTransfer(const char* filepath, uint8_t fileIdx) {
-    if (active) {
-        Serial.println("Transfer already in progress");
-        return false;
+// Streaming task configuration
+#define TRANSFER_TASK_STACK     4096
+#define TRANSFER_TASK_PRIO      4
+
+static TaskHandle_t s_transferTask = nullptr;
+static SemaphoreHandle_t s_startSem = nullptr;
+
+// Guards the job pool; enqueue runs on any task, dequeue on the
+// transfer task, and both critical sections are a few dozen cycles
+static portMUX_TYPE s_queueMux = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * Streaming task: parked until a job is enqueued, then drains the
+ * whole queue back-to-back without returning control between files.
+ */
+void fileTransferTask(void* param) {
+    FileTransfer* ft = (FileTransfer*)param;
+
+    while (true) {
+        if (xSemaphoreTake(s_startSem, portMAX_DELAY) == pdTRUE) {
+            ft->runQueue();
+        }
+    }
+}
+
+bool FileTransfer::allocBuffers() {
+    for (int i = 0; i < 2; i++) {
+        if (!chunkBuf[i]) {
+            chunkBuf[i] = spiFpga.acquireDmaBuffer(
+                CHUNK_HEADER_SIZE + TRANSFER_CHUNK_SIZE);
+            if (!chunkBuf[i]) {
+                Serial.println("Failed to allocate transfer buffers");
+                return false;
+            }
+        }
     }
+    return true;
+}
 
-    // Open file
-    File f = SD.open(filepath, FILE_READ);
-    if (!f) {
+/**
+ * Read a RIM tape from SD and decode it to the packed 18-bit word
+ * image (see rim_decoder.h). Leader/trailer bytes are stripped, so the
+ * decoded image is smaller than the raw tape and the FPGA loader can
+ * shift words straight into memory. The decoded artifact is handed to
+ * the image cache; if the cache takes it, future loads of the same
+ * tape skip both the card and the decode.
+ */
+bool FileTransfer::decodeRim(const char* filepath) {
+    sdFile = SD.open(filepath, FILE_READ);
+    if (!sdFile) {
         Serial.printf("Failed to open file: %s\n", filepath);
         return false;
     }
 
-    // Store file info
-    fileSize = f.size();
-    bytesTransferred = 0;
-    fileType = fileIdx;
-    active = true;
-    state = TRANSFER_STARTING;
+    size_t rawSize = sdFile.size();
+    size_t bound = rimDecodedBound(rawSize);
 
-    // Extract filename from path
-    const char* name = filepath;
-    const char* lastSlash = strrchr(filepath, '/');
-    if (lastSlash) {
-        name = lastSlash + 1;
+    // Decoded image need not be DMA-capable: chunks are memcpy'd into
+    // the DMA buffers at transfer time, same as cache hits
+    decodedData = (uint8_t*)heap_caps_malloc(bound, MALLOC_CAP_SPIRAM);
+    if (!decodedData) {
+        decodedData = (uint8_t*)heap_caps_malloc(bound, MALLOC_CAP_8BIT);
+    }
+    if (!decodedData) {
+        Serial.println("Failed to allocate RIM decode buffer");
+        sdFile.close();
+        return false;
     }
-    strncpy(filename, name, sizeof(filename) - 1);
-    filename[sizeof(filename) - 1] = '\0';
 
-    // Convert Arduino File to FILE* is not direct, use file handle differently
-    file = (FILE*)malloc(sizeof(File));
-    memcpy(file, &f, sizeof(File));
+    // Stream the tape through the decoder, one chunk buffer at a time
+    // (the transfer pipeline has not started, so chunkBuf[0] is free)
+    RimDecoder decoder;
+    decoder.reset();
+    size_t decodedSize = 0;
+
+    while (true) {
+        size_t n = sdFile.read(chunkBuf[0] + CHUNK_HEADER_SIZE,
+                               TRANSFER_CHUNK_SIZE);
+        if (n == 0) {
+            break;
+        }
+        decodedSize += decoder.feed(chunkBuf[0] + CHUNK_HEADER_SIZE, n,
+                                    decodedData + decodedSize,
+                                    bound - decodedSize);
+    }
+    sdFile.close();
 
-    Serial.printf("Starting transfer: %s (%lu bytes, type %d)\n",
-                  filename, fileSize, fileType);
+    if (decodedSize == 0 || (decodedSize % 3) != 0) {
+        Serial.printf("Not a valid RIM tape: %s\n", filepath);
+        releaseDecoded();
+        return false;
+    }
+
+    Serial.printf("RIM decoded: %u -> %u bytes (%u words)\n",
+                  (unsigned)rawSize, (unsigned)decodedSize,
+                  (unsigned)(decodedSize / 3));
+
+    // Hand the decoded image to the cache; on success the cache copy
+    // becomes the transfer source and the scratch buffer is freed
+    if (imageCache.beginStore(filepath, decodedSize)) {
+        imageCache.appendStore(decodedData, decodedSize);
+        imageCache.commitStore();
+        cachedData = imageCache.lookup(filepath, nullptr);
+        if (cachedData) {
+            releaseDecoded();
+        }
+    }
+    if (!cachedData) {
+        cachedData = decodedData;
+    }
 
+    fileSize = decodedSize;
     return true;
 }
 
-bool FileTransfer::processTransfer() {
-    if (!active) {
-        return false;
+void FileTransfer::releaseDecoded() {
+    if (decodedData) {
+        heap_caps_free(decodedData);
+        decodedData = nullptr;
     }
+}
 
-    switch (state) {
-        case TRANSFER_STARTING:
-            state = TRANSFER_SENDING_HEADER;
-            return true;
+// ============================================================================
+// Job Queue
+// ============================================================================
 
-        case TRANSFER_SENDING_HEADER:
-            if (sendHeader()) {
-                state = TRANSFER_SENDING_DATA;
-            } else {
-                state = TRANSFER_ERROR;
-                abortTransfer();
-                return false;
-            }
-            return true;
+// Pool admission only; the preempt decision is made by the caller
+bool FileTransfer::queueJob(const char* filepath, uint8_t fileType,
+                            uint8_t priority) {
+    if (strlen(filepath) >= sizeof(jobPool[0].path)) {
+        return false;
+    }
 
-        case TRANSFER_SENDING_DATA:
-            if (bytesTransferred >= fileSize) {
-                state = TRANSFER_COMPLETING;
-            } else if (!sendDataChunk()) {
-                state = TRANSFER_ERROR;
-                abortTransfer();
-                return false;
-            }
-            return true;
+    portENTER_CRITICAL(&s_queueMux);
+    TransferJob* job = nullptr;
+    for (size_t i = 0; i < TRANSFER_QUEUE_DEPTH; i++) {
+        if (!jobPool[i].used) {
+            job = &jobPool[i];
+            break;
+        }
+    }
+    if (job) {
+        strcpy(job->path, filepath);
+        job->fileType = fileType;
+        job->priority = priority;
+        job->seq = ++jobSeq;
+        job->used = true;
+    }
+    portEXIT_CRITICAL(&s_queueMux);
 
-        case TRANSFER_COMPLETING:
-            if (completeTransfer()) {
-                active = false;
-                state = TRANSFER_IDLE;
-                Serial.println("Transfer completed successfully");
-                return false;  // Done
-            }
-            return true;
+    return job != nullptr;
+}
 
-        case TRANSFER_ERROR:
-        case TRANSFER_IDLE:
-        default:
-            return false;
+// Highest priority first, FIFO (lowest seq) within a priority
+bool FileTransfer::takeNextJob(TransferJob& out) {
+    portENTER_CRITICAL(&s_queueMux);
+    TransferJob* best = nullptr;
+    for (size_t i = 0; i < TRANSFER_QUEUE_DEPTH; i++) {
+        TransferJob& j = jobPool[i];
+        if (!j.used) {
+            continue;
+        }
+        if (!best || j.priority > best->priority ||
+            (j.priority == best->priority && j.seq < best->seq)) {
+            best = &j;
+        }
+    }
+    if (best) {
+        out = *best;
+        best->used = false;
     }
+    portEXIT_CRITICAL(&s_queueMux);
+
+    return best != nullptr;
 }
 
-bool FileTransfer::sendHeader() {
-    // Assert FPGA IRQ to signal transfer start
-    digitalWrite(FPGA_IRQ_PIN, HIGH);
-    delayMicroseconds(10);
+size_t FileTransfer::getQueuedCount() {
+    size_t count = 0;
+    portENTER_CRITICAL(&s_queueMux);
+    for (size_t i = 0; i < TRANSFER_QUEUE_DEPTH; i++) {
+        if (jobPool[i].used) {
+            count++;
+        }
+    }
+    portEXIT_CRITICAL(&s_queueMux);
+    return count;
+}
 
-    // Select FPGA for SPI transfer
-    digitalWrite(FPGA_CS_PIN, LOW);
+// Called once from setup(), before the tasks that enqueue exist, so
+// the check-then-create here cannot race
+bool FileTransfer::init() {
+    if (s_transferTask) {
+        return true;
+    }
 
-    // Send transfer start command
-    SPI.transfer(CMD_TRANSFER_START);
-    SPI.transfer(fileType);
+    s_startSem = xSemaphoreCreateBinary();
+    if (!s_startSem) {
+        return false;
+    }
 
-    // Send file size (32-bit, little-endian)
-    SPI.transfer(fileSize & 0xFF);
-    SPI.transfer((fileSize >> 8) & 0xFF);
-    SPI.transfer((fileSize >> 16) & 0xFF);
-    SPI.transfer((fileSize >> 24) & 0xFF);
+    xTaskCreatePinnedToCore(fileTransferTask, "file_xfer",
+                            TRANSFER_TASK_STACK, this,
+                            TRANSFER_TASK_PRIO, &s_transferTask, 0);
+    return s_transferTask != nullptr;
+}
 
-    // Deselect FPGA
-    digitalWrite(FPGA_CS_PIN, HIGH);
+bool FileTransfer::enqueueTransfer(const char* filepath, uint8_t fileType,
+                                   uint8_t priority) {
+    if (!s_transferTask) {
+        ringLog.write("XFER", "Not initialized: %s", filepath);
+        return false;
+    }
 
-    // Clear IRQ
-    digitalWrite(FPGA_IRQ_PIN, LOW);
+    if (!queueJob(filepath, fileType, priority)) {
+        ringLog.write("XFER", "Transfer queue full: %s", filepath);
+        return false;
+    }
 
-    // Wait for FPGA ready (check status)
-    delayMicroseconds(100);
+    // A higher-priority job bumps an in-flight stream at the next
+    // chunk boundary; the preempted file is requeued automatically
+    if (active && priority > activePriority) {
+        preemptRequested = true;
+    }
 
-    Serial.printf("Header sent: type=%d, size=%lu\n", fileType, fileSize);
+    // Wake the streaming task. The binary semaphore coalesces wakes;
+    // runQueue() drains the pool anyway.
+    xSemaphoreGive(s_startSem);
 
     return true;
 }
 
-bool FileTransfer::sendDataChunk() {
-    File* f = (File*)file;
+bool FileTransfer::startTransfer(const char* filepath, uint8_t fileIdx) {
+    // Single-file entry point: a user-priority job on the same queue
+    return enqueueTransfer(filepath, fileIdx, TRANSFER_PRI_USER);
+}
+
+/**
+ * Drain the queue on the transfer task: session setup with N queued
+ * files runs as one uninterrupted streaming session, the header of
+ * file K+1 following the end marker of file K with no idle gap.
+ */
+void FileTransfer::runQueue() {
+    TransferJob job;
+    while (takeNextJob(job)) {
+        if (!beginJob(job)) {
+            continue;  // Bad file: log happened inside, keep draining
+        }
+        streamFile();
+    }
+}
 
-    // Read chunk from file
-    size_t toRead = min((size_t)(fileSize - bytesTransferred), TRANSFER_CHUNK_SIZE);
-    size_t bytesRead = f->read(buffer, toRead);
+/**
+ * Prepare one dequeued job: resolve the source (cache hit, RIM decode,
+ * or SD stream) and set up the transfer state for streamFile().
+ */
+bool FileTransfer::beginJob(const TransferJob& job) {
+    const char* filepath = job.path;
+    uint8_t fileIdx = job.fileType;
 
-    if (bytesRead == 0) {
-        Serial.println("File read error");
+    if (!allocBuffers()) {
         return false;
     }
 
-    // Signal FPGA: data incoming
-    digitalWrite(FPGA_IRQ_PIN, HIGH);
-    delayMicroseconds(5);
+    currentJob = job;
+    activePriority = job.priority;
+    preemptRequested = false;
 
-    // Select FPGA
-    digitalWrite(FPGA_CS_PIN, LOW);
+    // RIM tapes are decoded on this side before shipping, so what the
+    // cache holds (and what the FPGA sees) is always the packed word
+    // image, never the raw tape
+    if (fileIdx == FILE_TYPE_RIM) {
+        fileIdx = FILE_TYPE_RIM_DECODED;
+    }
 
-    // Send data command
-    SPI.transfer(CMD_TRANSFER_DATA);
+    // Cache hit: stream from memory, skip the card entirely
+    uint32_t cachedSize = 0;
+    cachedData = imageCache.lookup(filepath, &cachedSize);
+    capturing = false;
+    readOffset = 0;
+
+    if (cachedData) {
+        fileSize = cachedSize;
+        Serial.printf("Image cache hit: %s\n", filepath);
+    } else if (fileIdx == FILE_TYPE_RIM_DECODED) {
+        // Decode the whole tape up front; the transfer then streams
+        // the decoded image exactly like a cache hit
+        if (!decodeRim(filepath)) {
+            return false;
+        }
+    } else {
+        // Open file
+        sdFile = SD.open(filepath, FILE_READ);
+        if (!sdFile) {
+            Serial.printf("Failed to open file: %s\n", filepath);
+            return false;
+        }
 
-    // Send chunk size
-    SPI.transfer(bytesRead & 0xFF);
+        fileSize = sdFile.size();
 
-    // Send data bytes
-    for (size_t i = 0; i < bytesRead; i++) {
-        SPI.transfer(buffer[i]);
+        // Capture the stream into the cache for the next reload
+        capturing = imageCache.beginStore(filepath, fileSize);
     }
 
-    // Deselect FPGA
-    digitalWrite(FPGA_CS_PIN, HIGH);
-
-    // Clear IRQ
-    digitalWrite(FPGA_IRQ_PIN, LOW);
-
-    bytesTransferred += bytesRead;
+    // Store file info
+    bytesTransferred = 0;
+    fileType = fileIdx;
+    abortRequested = false;
+    active = true;
+    state = TRANSFER_STARTING;
 
-    // Progress output every 10%
-    static uint8_t lastProgress = 0;
-    uint8_t progress = getProgress();
-    if (progress >= lastProgress + 10) {
-        Serial.printf("Transfer progress: %d%%\n", progress);
-        lastProgress = progress;
+    // Extract filename from path
+    const char* name = filepath;
+    const char* lastSlash = strrchr(filepath, '/');
+    if (lastSlash) {
+        name = lastSlash + 1;
     }
+    strncpy(filename, name, sizeof(filename) - 1);
+    filename[sizeof(filename) - 1] = '\0';
 
-    // Small delay to let FPGA process
-    delayMicroseconds(50);
+    Serial.printf("Starting transfer: %s (%lu bytes, type %d)\n",
+                  filename, fileSize, fileType);
 
     return true;
 }
 
-bool FileTransfer::completeTransfer() {
-    File* f = (File*)file;
+bool FileTransfer::sendHeader() {
+    // Header payload: file type + 32-bit size (little-endian)
+    uint8_t header[5];
+    header[0] = fileType;
+    header[1] = fileSize & 0xFF;
+    header[2] = (fileSize >> 8) & 0xFF;
+    header[3] = (fileSize >> 16) & 0xFF;
+    header[4] = (fileSize >> 24) & 0xFF;
 
-    // Close file
-    f->close();
-    free(file);
-    file = nullptr;
+    spiFpga.sendCommand(CMD_TRANSFER_START, header, sizeof(header));
 
-    // Signal transfer complete
-    digitalWrite(FPGA_IRQ_PIN, HIGH);
-    delayMicroseconds(10);
+    Serial.printf("Header sent: type=%d, size=%lu\n", fileType, fileSize);
 
-    digitalWrite(FPGA_CS_PIN, LOW);
-    SPI.transfer(CMD_TRANSFER_END);
-    SPI.transfer(0x00);  // Success status
-    digitalWrite(FPGA_CS_PIN, HIGH);
+    // Closed-loop: wait for the FPGA to acknowledge the header instead
+    // of sleeping a fixed worst-case interval
+    return waitChunkAck();
+}
 
-    digitalWrite(FPGA_IRQ_PIN, LOW);
+/**
+ * Credit-based flow control: poll the FPGA status byte until it
+ * reports ready for the next chunk. On fast paths this returns on the
+ * first poll; the timeout only fires on a wedged or absent loader.
+ */
+bool FileTransfer::waitChunkAck() {
+    uint32_t start = millis();
+
+    while (true) {
+        uint8_t status = spiFpga.readTransferStatus();
+
+        if (status & FPGA_STATUS_ERROR) {
+            ringLog.write("XFER", "FPGA rejected chunk");
+            return false;
+        }
+        if (status & FPGA_STATUS_READY) {
+            return true;
+        }
+        if (millis() - start > CHUNK_ACK_TIMEOUT_MS) {
+            ringLog.write("XFER", "Timeout waiting for FPGA chunk ack");
+            return false;
+        }
+        taskYIELD();
+    }
+}
 
+bool FileTransfer::sendEnd() {
+    // Payload: status + whole-file CRC32 (little-endian) so the FPGA
+    // can cross-check its own accumulated checksum before handing the
+    // image to the core
+    uint8_t payload[5];
+    payload[0] = 0x00;  // Success
+    payload[1] = runningCrc & 0xFF;
+    payload[2] = (runningCrc >> 8) & 0xFF;
+    payload[3] = (runningCrc >> 16) & 0xFF;
+    payload[4] = (runningCrc >> 24) & 0xFF;
+    spiFpga.sendCommand(CMD_TRANSFER_END, payload, sizeof(payload));
     return true;
 }
 
-void FileTransfer::abortTransfer() {
-    if (file) {
-        File* f = (File*)file;
-        f->close();
-        free(file);
-        file = nullptr;
+void FileTransfer::setVerifyChunks(bool enable) {
+    verifyChunks = enable;
+}
+
+/**
+ * Diagnostic per-chunk verification: send the chunk's CRC32, and if
+ * the FPGA reports a mismatch, resend the same framed chunk up to
+ * MAX_CHUNK_RETRIES times. Only used when setVerifyChunks(true) - the
+ * happy path pays nothing for it.
+ */
+bool FileTransfer::verifyChunk(uint8_t* frame, size_t len) {
+    uint32_t crc = esp_rom_crc32_le(0, frame + CHUNK_HEADER_SIZE, len);
+    uint8_t payload[4];
+    payload[0] = crc & 0xFF;
+    payload[1] = (crc >> 8) & 0xFF;
+    payload[2] = (crc >> 16) & 0xFF;
+    payload[3] = (crc >> 24) & 0xFF;
+
+    for (int attempt = 0; attempt <= MAX_CHUNK_RETRIES; attempt++) {
+        if (attempt > 0) {
+            ringLog.write("XFER", "Chunk CRC mismatch, resend %d/%d",
+                         attempt, MAX_CHUNK_RETRIES);
+            if (!spiFpga.queueTransaction(frame, CHUNK_HEADER_SIZE + len)) {
+                return false;
+            }
+            spiFpga.waitAsyncIdle();
+        }
+
+        spiFpga.sendCommand(CMD_TRANSFER_CRC, payload, sizeof(payload));
+
+        uint32_t start = millis();
+        bool mismatch = false;
+        while (millis() - start <= CHUNK_ACK_TIMEOUT_MS) {
+            uint8_t status = spiFpga.readTransferStatus();
+            if (status & FPGA_STATUS_ERROR) {
+                mismatch = true;
+                break;
+            }
+            if (status & FPGA_STATUS_READY) {
+                return true;
+            }
+            taskYIELD();
+        }
+
+        if (!mismatch) {
+            ringLog.write("XFER", "Timeout waiting for chunk CRC check");
+            return false;
+        }
     }
 
-    // Signal abort to FPGA
-    digitalWrite(FPGA_IRQ_PIN, HIGH);
-    delayMicroseconds(10);
+    ringLog.write("XFER", "Chunk failed CRC after all retries");
+    return false;
+}
 
-    digitalWrite(FPGA_CS_PIN, LOW);
-    SPI.transfer(CMD_TRANSFER_ABORT);
-    digitalWrite(FPGA_CS_PIN, HIGH);
+/**
+ * Read the next chunk from the active source: cached image in memory
+ * or the SD card. SD reads are captured into the image cache.
+ */
+size_t FileTransfer::readChunk(uint8_t* dst) {
+    if (cachedData) {
+        size_t n = fileSize - readOffset;
+        if (n > TRANSFER_CHUNK_SIZE) {
+            n = TRANSFER_CHUNK_SIZE;
+        }
+        memcpy(dst, cachedData + readOffset, n);
+        readOffset += n;
+        return n;
+    }
 
-    digitalWrite(FPGA_IRQ_PIN, LOW);
+    size_t n = sdFile.read(dst, TRANSFER_CHUNK_SIZE);
+    if (capturing && n > 0) {
+        imageCache.appendStore(dst, n);
+    }
+    return n;
+}
+
+/**
+ * Double-buffered pipeline, runs on the transfer task:
+ *
+ *   read chunk 0 -> [ queue chunk N | read chunk N+1 ] -> drain -> end
+ *
+ * The queued DMA transaction carries the framed chunk directly from
+ * the read buffer; while it is in flight the other buffer is filled
+ * from SD. One transaction is outstanding at a time, which is enough
+ * to hide the shorter of the two latencies completely.
+ */
+void FileTransfer::streamFile() {
+    state = TRANSFER_SENDING_HEADER;
+    if (!sendHeader()) {
+        state = TRANSFER_ERROR;
+        abortTransfer();
+        return;
+    }
+
+    state = TRANSFER_SENDING_DATA;
+    runningCrc = 0;
+
+    // Prime the pipeline: read the first chunk
+    int cur = 0;
+    size_t pending = readChunk(chunkBuf[cur] + CHUNK_HEADER_SIZE);
+
+    while (pending > 0 && !abortRequested) {
+        // Per-chunk probe: covers queue, overlapped read, drain and ack
+        uint32_t chunkStart = perfCycles();
+
+        // Frame and queue chunk N
+        chunkBuf[cur][0] = CMD_TRANSFER_DATA;
+        chunkBuf[cur][1] = pending & 0xFF;
+        chunkBuf[cur][2] = (pending >> 8) & 0xFF;
+
+        if (!spiFpga.queueTransaction(chunkBuf[cur],
+                                      CHUNK_HEADER_SIZE + pending)) {
+            state = TRANSFER_ERROR;
+            break;
+        }
+
+        // Fold chunk N into the file CRC while its DMA transaction is
+        // in flight - the CPU only reads the buffer, so this costs no
+        // extra pass over the data and no wall-clock time
+        runningCrc = esp_rom_crc32_le(runningCrc,
+                                      chunkBuf[cur] + CHUNK_HEADER_SIZE,
+                                      pending);
+
+        bytesTransferred += pending;
+
+        // Read chunk N+1 while N is in flight
+        int next = cur ^ 1;
+        size_t nextLen = 0;
+        if (bytesTransferred < fileSize) {
+            nextLen = readChunk(chunkBuf[next] + CHUNK_HEADER_SIZE);
+            if (nextLen == 0) {
+                ringLog.write("XFER", "File read error");
+                state = TRANSFER_ERROR;
+            }
+        }
+
+        // Wait for chunk N before reusing its buffer, then for the
+        // FPGA's ack so the next chunk goes out the moment it is ready
+        spiFpga.waitAsyncIdle();
+
+        if (state == TRANSFER_ERROR) {
+            break;
+        }
+
+        if (verifyChunks) {
+            if (!verifyChunk(chunkBuf[cur], pending)) {
+                state = TRANSFER_ERROR;
+                break;
+            }
+        } else if (!waitChunkAck()) {
+            // Every chunk needs its ack, the last one included:
+            // waitAsyncIdle() only proves our DMA finished, not that
+            // the FPGA drained the chunk before CMD_TRANSFER_END
+            state = TRANSFER_ERROR;
+            break;
+        }
+
+        perfProbe.record(PERF_CHUNK_SEND, perfCycles() - chunkStart);
+
+        // A higher-priority job arrived: step aside at this chunk
+        // boundary and put the rest of this file back on the queue.
+        // The restart is cheap - the image is usually cached by then.
+        if (preemptRequested && !abortRequested) {
+            preemptRequested = false;
+            ringLog.write("XFER", "Preempted, requeued: %s",
+                          currentJob.path);
+            queueJob(currentJob.path, currentJob.fileType,
+                     currentJob.priority);
+            abortTransfer();
+            return;
+        }
+
+        cur = next;
+        pending = nextLen;
+    }
+
+    if (state == TRANSFER_ERROR || abortRequested) {
+        abortTransfer();
+        return;
+    }
+
+    state = TRANSFER_COMPLETING;
+    sendEnd();
+
+    if (!cachedData) {
+        sdFile.close();
+    }
+    if (capturing) {
+        imageCache.commitStore();
+        capturing = false;
+    }
+    cachedData = nullptr;
+    releaseDecoded();
+
+    active = false;
+    state = TRANSFER_IDLE;
+    Serial.println("Transfer completed successfully");
+
+    // Remember the image (original file type, not the decoded alias)
+    // for the boot-time autoload
+    settingsStore.saveLastImage(currentJob.path, currentJob.fileType);
+}
+
+bool FileTransfer::processTransfer() {
+    // Streaming now runs on its own task; this remains for callers
+    // that poll for completion.
+    return active;
+}
+
+void FileTransfer::abortTransfer() {
+    // From outside the transfer task, just request the stop; the task
+    // performs the actual teardown at the next chunk boundary.
+    if (xTaskGetCurrentTaskHandle() != s_transferTask && active) {
+        abortRequested = true;
+        return;
+    }
+
+    if (!cachedData && sdFile) {
+        sdFile.close();
+    }
+    if (capturing) {
+        imageCache.abortStore();
+        capturing = false;
+    }
+    cachedData = nullptr;
+    releaseDecoded();
+
+    // Signal abort to FPGA
+    spiFpga.sendCommand(CMD_TRANSFER_ABORT);
 
     active = false;
     state = TRANSFER_IDLE;
@@ -245,7 +659,9 @@ void FileTransfer::abortTransfer() {
 }
 
 bool FileTransfer::isActive() {
-    return active;
+    // Queued-but-not-started jobs count: callers polling for session
+    // completion care about the whole queue, not the current file
+    return active || getQueuedCount() > 0;
 }
 
 uint8_t FileTransfer::getProgress() {
@@ -270,15 +686,3 @@ uint32_t FileTransfer::getBytesTransferred() {
 uint32_t FileTransfer::getFileSize() {
     return fileSize;
 }
-
-void FileTransfer::signalFPGA(uint8_t command) {
-    // Generic FPGA command signal via IRQ pulse
-    digitalWrite(FPGA_IRQ_PIN, HIGH);
-    delayMicroseconds(5);
-
-    digitalWrite(FPGA_CS_PIN, LOW);
-    SPI.transfer(command);
-    digitalWrite(FPGA_CS_PIN, HIGH);
-
-    digitalWrite(FPGA_IRQ_PIN, LOW);
-}
@@ -1,11 +1,17 @@
 #pragma once
 #include <stdint.h>
-#include <stdio.h>
+#include <FS.h>
 
 // File type indices for FPGA loading
-#define FILE_TYPE_PDP_ROM   0   // PDP/ROM files
-#define FILE_TYPE_RIM       1   // RIM files
-#define FILE_TYPE_BIN       2   // BIN files
+#define FILE_TYPE_PDP_ROM       0   // PDP/ROM files
+#define FILE_TYPE_RIM           1   // RIM files (raw tape bytes)
+#define FILE_TYPE_BIN           2   // BIN files
+#define FILE_TYPE_RIM_DECODED   3   // RIM pre-decoded to packed 18-bit words
+
+// Job priorities: user-initiated loads preempt background prefetches
+// at the next chunk boundary
+#define TRANSFER_PRI_BACKGROUND 0
+#define TRANSFER_PRI_USER       1
 
 // Transfer states
 enum TransferState {
@@ -17,11 +23,41 @@ enum TransferState {
     TRANSFER_ERROR
 };
 
+/**
+ * Double-buffered file streaming engine.
+ *
+ * A dedicated FreeRTOS task pipelines SD reads against SPI DMA: while
+ * chunk N is in flight to the FPGA, chunk N+1 is read from the card
+ * into the second buffer, so the transfer runs at the speed of the
+ * slower of the two devices instead of their sum.
+ */
 class FileTransfer {
 public:
+    /**
+     * Create the streaming task and its wake semaphore. Call once from
+     * setup() before any task can enqueue; lazy creation from
+     * enqueueTransfer() would race between concurrent callers.
+     */
+    bool init();
+
     bool startTransfer(const char* filepath, uint8_t fileType);
-    bool processTransfer();  // Call from main loop
+
+    /**
+     * Queue a (filepath, file index) job. The streaming task executes
+     * queued jobs back-to-back in priority order (FIFO within a
+     * priority) with no gap between files; a TRANSFER_PRI_USER job
+     * preempts an in-flight background transfer at the next chunk
+     * boundary, and the preempted file is requeued behind it.
+     *
+     * @return false if the queue is full
+     */
+    bool enqueueTransfer(const char* filepath, uint8_t fileType,
+                         uint8_t priority = TRANSFER_PRI_USER);
+
+    size_t getQueuedCount();
+    bool processTransfer();  // Legacy poll hook; streaming runs in the task
     void abortTransfer();
+    void setVerifyChunks(bool enable);  // Per-chunk CRC check (diagnostics)
     bool isActive();
     uint8_t getProgress();  // 0-100%
     TransferState getState();
@@ -29,23 +65,80 @@ public:
     uint32_t getBytesTransferred();
     uint32_t getFileSize();
 
+    // Chunk size per pipelined buffer (framed chunk must fit one
+    // SPI transaction)
+    static const size_t TRANSFER_CHUNK_SIZE = 4096;
+
+    // How long to wait for the FPGA to accept the next chunk before
+    // declaring the transfer failed
+    static const uint32_t CHUNK_ACK_TIMEOUT_MS = 50;
+
+    // Resend attempts per chunk when per-chunk verification is on
+    static const int MAX_CHUNK_RETRIES = 3;
+
+    // Queued jobs (static pool; jobs are small, the files are not)
+    static const size_t TRANSFER_QUEUE_DEPTH = 8;
+
 private:
-    FILE* file;
+    struct TransferJob {
+        char path[128];
+        uint8_t fileType;
+        uint8_t priority;
+        uint32_t seq;       // FIFO order within a priority
+        bool used;
+    };
+
+    // Job pool and scheduling state
+    TransferJob jobPool[TRANSFER_QUEUE_DEPTH];
+    uint32_t jobSeq = 0;
+    TransferJob currentJob;             // Requeued on preemption
+    volatile uint8_t activePriority = 0;
+    volatile bool preemptRequested = false;
+
+    File sdFile;
     uint32_t fileSize;
     uint32_t bytesTransferred;
     uint8_t fileType;
-    bool active;
+    volatile bool active;
+    volatile bool abortRequested;
     TransferState state;
     char filename[32];
 
-    // Transfer buffer
-    static const size_t TRANSFER_CHUNK_SIZE = 256;
-    uint8_t buffer[TRANSFER_CHUNK_SIZE];
+    // Image cache integration: on a hit the transfer streams from
+    // memory (cachedData) with zero SD I/O; on a miss the SD stream
+    // is captured into the cache for next time
+    const uint8_t* cachedData;
+    uint32_t readOffset;
+    bool capturing;
+
+    // RIM preprocessing: decoded word image owned by this transfer
+    // when the cache could not take it (freed at completion/abort)
+    uint8_t* decodedData;
 
+    // Whole-file CRC32, accumulated chunk by chunk while each DMA
+    // transaction is in flight, reported in CMD_TRANSFER_END
+    uint32_t runningCrc;
+    bool verifyChunks;
+
+    // Double buffers (DMA-capable, allocated once on first transfer)
+    uint8_t* chunkBuf[2];
+
+    bool allocBuffers();
+    bool decodeRim(const char* filepath);
+    size_t readChunk(uint8_t* dst);
+    void releaseDecoded();
+    bool queueJob(const char* filepath, uint8_t fileType,
+                  uint8_t priority);
+    bool takeNextJob(TransferJob& out);
+    bool beginJob(const TransferJob& job);
+    void runQueue();
+    void streamFile();
     bool sendHeader();
-    bool sendDataChunk();
-    bool completeTransfer();
-    void signalFPGA(uint8_t command);
+    bool sendEnd();
+    bool waitChunkAck();
+    bool verifyChunk(uint8_t* frame, size_t len);
+
+    friend void fileTransferTask(void* param);
 };
 
 extern FileTransfer fileTransfer;
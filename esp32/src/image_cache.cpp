@@ -0,0 +1,216 @@
+/**
+ * image_cache.cpp - ROM/RIM Image Cache Implementation
+ *
+ * Keeps recently loaded images resident so repeat loads skip the SD
+ * card entirely. PSRAM-equipped boards get a generous budget; others
+ * fall back to a slice of internal RAM that still covers the typical
+ * 8 KB RIM tapes.
+ */
+
+#include "image_cache.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+
+// Global instance
+ImageCache imageCache;
+
+// Cache budgets by memory type
+#define CACHE_BUDGET_PSRAM   (512 * 1024)
+#define CACHE_BUDGET_DRAM    (64 * 1024)
+
+bool ImageCache::init() {
+    memset(slots, 0, sizeof(slots));
+    used = 0;
+    clock = 0;
+    storeSlot = nullptr;
+
+    if (heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0) {
+        budget = CACHE_BUDGET_PSRAM;
+        Serial.printf("Image cache: %u KB in PSRAM\n", budget / 1024);
+    } else {
+        budget = CACHE_BUDGET_DRAM;
+        Serial.printf("Image cache: %u KB in internal RAM\n", budget / 1024);
+    }
+
+    return budget > 0;
+}
+
+uint8_t* ImageCache::allocImage(size_t size) {
+    // Prefer PSRAM; images are memcpy'd into DMA buffers at transfer
+    // time, so the cache itself need not be DMA-capable
+    uint8_t* p = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+    if (!p) {
+        p = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_8BIT);
+    }
+    return p;
+}
+
+ImageCache::Slot* ImageCache::findSlot(const char* path) {
+    for (size_t i = 0; i < IMAGE_SLOTS; i++) {
+        if (slots[i].valid && strcmp(slots[i].path, path) == 0) {
+            return &slots[i];
+        }
+    }
+    return nullptr;
+}
+
+bool ImageCache::evictOne() {
+    Slot* victim = nullptr;
+    for (size_t i = 0; i < IMAGE_SLOTS; i++) {
+        if (!slots[i].valid || &slots[i] == storeSlot) {
+            continue;
+        }
+        if (!victim || slots[i].lastUsed < victim->lastUsed) {
+            victim = &slots[i];
+        }
+    }
+
+    if (!victim) {
+        return false;
+    }
+
+    heap_caps_free(victim->data);
+    used -= victim->size;
+    victim->data = nullptr;
+    victim->valid = false;
+    return true;
+}
+
+const uint8_t* ImageCache::lookup(const char* path, uint32_t* sizeOut) {
+    Slot* slot = findSlot(path);
+    if (!slot) {
+        return nullptr;
+    }
+
+    slot->lastUsed = ++clock;
+    if (sizeOut) {
+        *sizeOut = slot->size;
+    }
+    return slot->data;
+}
+
+bool ImageCache::beginStore(const char* path, uint32_t size) {
+    if (storeSlot || size == 0 || size > budget ||
+        strlen(path) >= sizeof(Slot::path)) {
+        return false;
+    }
+
+    // Replace any stale copy of the same file
+    Slot* existing = findSlot(path);
+    if (existing) {
+        heap_caps_free(existing->data);
+        used -= existing->size;
+        existing->data = nullptr;
+        existing->valid = false;
+    }
+
+    // Evict until the image fits in the budget
+    while (used + size > budget) {
+        if (!evictOne()) {
+            return false;
+        }
+    }
+
+    // Find a free slot (evict LRU if all are occupied)
+    Slot* slot = nullptr;
+    for (size_t i = 0; i < IMAGE_SLOTS; i++) {
+        if (!slots[i].valid) {
+            slot = &slots[i];
+            break;
+        }
+    }
+    if (!slot) {
+        if (!evictOne()) {
+            return false;
+        }
+        for (size_t i = 0; i < IMAGE_SLOTS; i++) {
+            if (!slots[i].valid) {
+                slot = &slots[i];
+                break;
+            }
+        }
+    }
+
+    slot->data = allocImage(size);
+    if (!slot->data) {
+        return false;
+    }
+
+    strcpy(slot->path, path);
+    slot->size = size;
+    slot->valid = false;  // Hidden from lookup until commit
+    used += size;
+
+    storeSlot = slot;
+    storeOffset = 0;
+    return true;
+}
+
+void ImageCache::appendStore(const uint8_t* data, size_t len) {
+    if (!storeSlot) {
+        return;
+    }
+
+    if (storeOffset + len > storeSlot->size) {
+        // Transfer produced more data than announced; drop the capture
+        abortStore();
+        return;
+    }
+
+    memcpy(storeSlot->data + storeOffset, data, len);
+    storeOffset += len;
+}
+
+void ImageCache::commitStore() {
+    if (!storeSlot) {
+        return;
+    }
+
+    if (storeOffset == storeSlot->size) {
+        storeSlot->valid = true;
+        storeSlot->lastUsed = ++clock;
+        Serial.printf("Image cached: %s (%lu bytes)\n",
+                      storeSlot->path, (unsigned long)storeSlot->size);
+    } else {
+        // Short capture: discard
+        heap_caps_free(storeSlot->data);
+        used -= storeSlot->size;
+        storeSlot->data = nullptr;
+    }
+
+    storeSlot = nullptr;
+}
+
+void ImageCache::abortStore() {
+    if (!storeSlot) {
+        return;
+    }
+
+    heap_caps_free(storeSlot->data);
+    used -= storeSlot->size;
+    storeSlot->data = nullptr;
+    storeSlot->valid = false;
+    storeSlot = nullptr;
+}
+
+void ImageCache::invalidate(const char* path) {
+    for (size_t i = 0; i < IMAGE_SLOTS; i++) {
+        if (slots[i].valid && (!path || strcmp(slots[i].path, path) == 0)) {
+            heap_caps_free(slots[i].data);
+            used -= slots[i].size;
+            slots[i].data = nullptr;
+            slots[i].valid = false;
+        }
+    }
+}
+
+const char* ImageCache::getMostRecentPath() {
+    Slot* best = nullptr;
+    for (size_t i = 0; i < IMAGE_SLOTS; i++) {
+        if (slots[i].valid && (!best || slots[i].lastUsed > best->lastUsed)) {
+            best = &slots[i];
+        }
+    }
+    return best ? best->path : nullptr;
+}
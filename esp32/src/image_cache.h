@@ -0,0 +1,85 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * LRU cache of recently loaded ROM/RIM images.
+ *
+ * Players reload the same handful of tapes dozens of times per
+ * session; a hit here streams straight from memory into the transfer
+ * path with zero SD I/O. Slots are keyed by file path and allocated
+ * from PSRAM where fitted, falling back to a smaller internal-RAM
+ * budget otherwise. Images larger than the budget are simply not
+ * cached.
+ */
+class ImageCache {
+public:
+    /**
+     * @brief Size the cache budget (detects PSRAM)
+     * @return true if caching is available
+     */
+    bool init();
+
+    /**
+     * @brief Look up a cached image by path
+     * @param path Full file path used at load time
+     * @param sizeOut Receives the image size on a hit
+     * @return Pointer to image data, or nullptr on miss
+     */
+    const uint8_t* lookup(const char* path, uint32_t* sizeOut);
+
+    /**
+     * @brief Start capturing an image as it streams from SD
+     *
+     * Evicts least-recently-used slots until the image fits. Capture
+     * is best-effort: failure to allocate just disables it for this
+     * load.
+     *
+     * @param path Full file path (cache key)
+     * @param size Final image size in bytes
+     * @return true if capture is active
+     */
+    bool beginStore(const char* path, uint32_t size);
+
+    /** @brief Append a chunk to the capture in progress */
+    void appendStore(const uint8_t* data, size_t len);
+
+    /** @brief Seal the capture and make the slot visible to lookup() */
+    void commitStore();
+
+    /** @brief Discard a partial capture (failed or aborted transfer) */
+    void abortStore();
+
+    /** @brief Drop a cached image (or all of them when path is null) */
+    void invalidate(const char* path = nullptr);
+
+    /** @brief Path of the most recently used cached image, or nullptr */
+    const char* getMostRecentPath();
+
+    // Number of cached images
+    static const size_t IMAGE_SLOTS = 8;
+
+private:
+    struct Slot {
+        char path[128];
+        uint32_t size;
+        uint8_t* data;
+        uint32_t lastUsed;
+        bool valid;
+    };
+
+    Slot slots[IMAGE_SLOTS];
+    size_t budget = 0;        // Total bytes the cache may hold
+    size_t used = 0;          // Bytes currently held
+    uint32_t clock = 0;       // LRU tick
+
+    // Capture in progress
+    Slot* storeSlot = nullptr;
+    uint32_t storeOffset = 0;
+
+    Slot* findSlot(const char* path);
+    bool evictOne();
+    uint8_t* allocImage(size_t size);
+};
+
+extern ImageCache imageCache;
@@ -3,22 +3,71 @@
  * @brief ESP32 OSD Controller for PDP-1 Emulator
  *
  * Main application with PDP-1 specific menu structure.
- * Handles SPI communication with FPGA for OSD overlay.
+ * Runs as FreeRTOS tasks pinned across both cores: a GPIO-interrupt
+ * driven input task on core 0 and a render/SPI task on core 1,
+ * communicating through event queues instead of polling.
  */
 
 #include <Arduino.h>
-#include <SPI.h>
+#include <SD.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include <esp_timer.h>
 #include "config.h"
 #include "osd_menu.h"
+#include "spi_fpga.h"
+#include "file_browser.h"
+#include "file_transfer.h"
+#include "image_cache.h"
+#include "settings.h"
+#include "ring_log.h"
+#include "perf_probe.h"
 
 // ============================================================================
 // Global State
 // ============================================================================
 
 OSDMenu osdMenu;
-uint8_t osdBuffer[OSD_BUFFER_SIZE];
 
-// Settings storage
+// OSD framebuffer, DMA-capable so frame uploads go to the SPI
+// peripheral with zero staging copies (allocated in setup())
+uint8_t* osdBuffer = nullptr;
+
+// Task and queue configuration
+#define INPUT_TASK_STACK     2048
+#define RENDER_TASK_STACK    4096
+#define INPUT_TASK_PRIO      5     // Input above render: latency matters
+#define RENDER_TASK_PRIO     3
+#define INPUT_QUEUE_LEN      8
+#define NAV_QUEUE_LEN        8
+#define RENDER_PERIOD_MS     33    // 30 fps frame cap
+
+// Input event from the IRQ ISR (or the repeat timer) to the consumers
+struct InputEvent {
+    uint32_t timestampUs;
+    bool isRepeat;       // Injected by the repeat timer, not a new edge
+};
+
+static QueueHandle_t s_inputQueue = nullptr;  // ISR -> input task
+static QueueHandle_t s_navQueue = nullptr;    // Input task -> render task
+static TaskHandle_t s_inputTask = nullptr;
+static TaskHandle_t s_renderTask = nullptr;
+
+// Auto-repeat: while a direction key is held, a hardware timer injects
+// repeat events at MENU_REPEAT_MS so held keys scroll without the FPGA
+// having to re-raise the IRQ line
+static esp_timer_handle_t s_repeatTimer = nullptr;
+
+// Parallel boot: SD probe runs on core 0 while setup() trains the SPI
+// link on core 1; autoboot waits on this handshake
+#define SD_INIT_TASK_STACK  4096
+#define SD_INIT_TASK_PRIO   3
+#define SD_READY_WAIT_MS    3000
+static SemaphoreHandle_t s_sdReadySem = nullptr;
+static volatile bool s_sdOk = false;
+
+// Settings storage (defaults; overwritten from NVS at boot)
 bool settingAspectWide = false;
 bool settingHwMultiply = true;
 bool settingVarBrightness = true;
@@ -31,14 +80,19 @@ char rimFilePath[128] = "";
 // Menu Callbacks
 // ============================================================================
 
-void onLoadROM(MenuItem* item) {
-    Serial.println("Load ROM File requested");
-    // TODO: Trigger file browser via SPI command
-}
+// Browser committed a selection: start the transfer to the FPGA. The
+// target slot follows from which item opened the browser; .rim payloads
+// are decoded to packed words inside the transfer engine.
+void onFileSelected(MenuItem* item, const char* path) {
+    uint8_t type = FILE_TYPE_PDP_ROM;
+    if (item->fileSelect.selectedPath == rimFilePath) {
+        type = FILE_TYPE_RIM;
+    }
 
-void onLoadRIM(MenuItem* item) {
-    Serial.println("Load RIM File requested");
-    // TODO: Trigger file browser via SPI command
+    Serial.printf("Loading %s\n", path);
+    if (!fileTransfer.startTransfer(path, type)) {
+        Serial.println("Transfer start failed");
+    }
 }
 
 void onReset(MenuItem* item) {
@@ -75,63 +129,55 @@ MenuItem rootMenu = MENU_SUBMENU("PDP-1 Emulator", mainMenuItems,
 // SPI Communication
 // ============================================================================
 
-SPIClass* hspi = nullptr;
-
-void initSPI() {
-    hspi = new SPIClass(HSPI);
-    hspi->begin(PIN_SPI_CLK, PIN_SPI_MISO, PIN_SPI_MOSI, PIN_SPI_CS);
-    pinMode(PIN_SPI_CS, OUTPUT);
-    digitalWrite(PIN_SPI_CS, HIGH);
-}
-
 void sendOSDBuffer() {
-    digitalWrite(PIN_SPI_CS, LOW);
-    hspi->beginTransaction(SPISettings(SPI_CLOCK_HZ, MSBFIRST, SPI_MODE0));
-
-    // Send command byte (0x01 = OSD buffer update)
-    hspi->transfer(0x01);
-
-    // Send buffer data
-    for (int i = 0; i < OSD_BUFFER_SIZE; i++) {
-        hspi->transfer(osdBuffer[i]);
-    }
-
-    hspi->endTransaction();
-    digitalWrite(PIN_SPI_CS, HIGH);
+    // Full-frame DMA upload via SPIFpga driver
+    spiFpga.sendOsdFrame(osdBuffer);
 }
 
 void sendOSDVisibility(bool visible) {
-    digitalWrite(PIN_SPI_CS, LOW);
-    hspi->beginTransaction(SPISettings(SPI_CLOCK_HZ, MSBFIRST, SPI_MODE0));
-
-    // Send command byte (0x02 = OSD visibility)
-    hspi->transfer(0x02);
-    hspi->transfer(visible ? 0x01 : 0x00);
-
-    hspi->endTransaction();
-    digitalWrite(PIN_SPI_CS, HIGH);
+    spiFpga.setOsdEnable(visible);
 }
 
 // ============================================================================
 // Input Handling
 // ============================================================================
 
-NavCommand readNavInput() {
-    // Check for interrupt from FPGA
-    if (!digitalRead(PIN_OSD_IRQ)) {
-        return NAV_NONE;
-    }
+// IRQ edge from FPGA: timestamp and hand off to the input task
+static void IRAM_ATTR osdIrqISR() {
+    InputEvent event;
+    event.timestampUs = (uint32_t)esp_timer_get_time();
+    event.isRepeat = false;
 
-    // Read command from FPGA via SPI
-    digitalWrite(PIN_SPI_CS, LOW);
-    hspi->beginTransaction(SPISettings(SPI_CLOCK_HZ, MSBFIRST, SPI_MODE0));
+    BaseType_t woken = pdFALSE;
+    xQueueSendFromISR(s_inputQueue, &event, &woken);
+    if (woken) {
+        portYIELD_FROM_ISR();
+    }
+}
 
-    hspi->transfer(0x10);  // Read input command
-    uint8_t input = hspi->transfer(0x00);
+// Repeat timer tick: inject a repeat event straight to the render/SPI
+// task, which re-reads the input and stops the timer on key release
+static void repeatTimerCb(void* arg) {
+    InputEvent event;
+    event.timestampUs = (uint32_t)esp_timer_get_time();
+    event.isRepeat = true;
+    xQueueSend(s_navQueue, &event, 0);
+}
 
-    hspi->endTransaction();
-    digitalWrite(PIN_SPI_CS, HIGH);
+/**
+ * SD probe, first directory scan, and image cache sizing, run off the
+ * boot-critical path. The root scan doubles as the directory index
+ * warm, so the browser's first open costs one RAM-cache hit.
+ */
+static void sdInitTask(void* param) {
+    s_sdOk = fileBrowser.init();
+    imageCache.init();
+    xSemaphoreGive(s_sdReadySem);
+    vTaskDelete(nullptr);
+}
 
+// Map raw FPGA input code to navigation command
+static NavCommand decodeNavInput(uint8_t input) {
     switch (input) {
         case 0x01: return NAV_UP;
         case 0x02: return NAV_DOWN;
@@ -139,15 +185,201 @@ NavCommand readNavInput() {
         case 0x04: return NAV_RIGHT;
         case 0x05: return NAV_SELECT;
         case 0x06: return NAV_BACK;
-        case 0x10: // Menu toggle
-            if (!osdMenu.isVisible()) {
-                osdMenu.setVisible(true);
-                return NAV_NONE;
+    }
+    return NAV_NONE;
+}
+
+/**
+ * Input task (core 0): blocks on IRQ events from the ISR, debounces
+ * them on the ISR timestamp, and forwards accepted edges to the
+ * render/SPI task. All SPI traffic stays on one task so the bus never
+ * sees concurrent masters.
+ */
+static void inputTask(void* param) {
+    InputEvent event;
+    uint32_t lastAcceptUs = 0;
+
+    while (true) {
+        if (xQueueReceive(s_inputQueue, &event, portMAX_DELAY) == pdTRUE) {
+            // Debounce on the ISR timestamp: contact bounce re-raises
+            // the IRQ line within MENU_DEBOUNCE_MS of the real edge
+            if (event.timestampUs - lastAcceptUs <
+                (uint32_t)MENU_DEBOUNCE_MS * 1000) {
+                continue;
             }
-            break;
+            lastAcceptUs = event.timestampUs;
+            xQueueSend(s_navQueue, &event, 0);
+        }
     }
+}
 
-    return NAV_NONE;
+/**
+ * Render/SPI task (core 1): owns all SPI traffic. Blocks on forwarded
+ * input events with a frame-period timeout, so the task sleeps (and the
+ * bus is silent) whenever the menu is idle.
+ */
+// Progress overlay pacing: ~5 Hz is smooth to the eye and costs two
+// OSD lines of SPI per update
+#define PROGRESS_PERIOD_MS   200
+
+static void renderTask(void* param) {
+    bool lastVisible = false;
+    uint32_t lastRender = 0;
+    InputEvent event;
+
+    // Transfer progress overlay state
+    bool progressShown = false;
+    uint32_t lastProgressMs = 0;
+    uint32_t lastProgressBytes = 0;
+
+    while (true) {
+        // Sleep until input arrives or the next frame period elapses
+        bool haveEvent = (xQueueReceive(s_navQueue, &event,
+                                        pdMS_TO_TICKS(RENDER_PERIOD_MS)) == pdTRUE);
+
+        // Tick probe starts after the sleep so it measures work, not idle
+        uint32_t tickStart = perfCycles();
+
+        if (haveEvent) {
+            // One SPI read per IRQ edge (or repeat tick) instead of
+            // per-loop polling
+            uint8_t input = spiFpga.readInput();
+
+            if (input == 0x00) {
+                // Key released: stop auto-repeat
+                esp_timer_stop(s_repeatTimer);
+            } else if (input == 0x10 && !event.isRepeat) {
+                // Menu toggle
+                if (!osdMenu.isVisible()) {
+                    osdMenu.setVisible(true);
+                } else {
+                    osdMenu.setVisible(false);
+                }
+            } else {
+                NavCommand nav = decodeNavInput(input);
+                if (nav != NAV_NONE) {
+                    osdMenu.navigate(nav);
+
+                    // IRQ-edge-to-navigation latency in cycles
+                    uint32_t latencyUs =
+                        (uint32_t)esp_timer_get_time() - event.timestampUs;
+                    perfProbe.record(PERF_INPUT_LATENCY,
+                                     latencyUs * getCpuFrequencyMhz());
+
+                    // Direction keys auto-repeat while held; the timer
+                    // is periodic, so re-starting on a fresh edge just
+                    // resets the phase
+                    bool repeatable = (nav == NAV_UP || nav == NAV_DOWN ||
+                                       nav == NAV_LEFT || nav == NAV_RIGHT);
+                    if (repeatable && !event.isRepeat) {
+                        esp_timer_stop(s_repeatTimer);
+                        esp_timer_start_periodic(
+                            s_repeatTimer, (uint64_t)MENU_REPEAT_MS * 1000);
+                    } else if (!repeatable) {
+                        esp_timer_stop(s_repeatTimer);
+                    }
+                }
+            }
+        }
+
+        // Open this tick's command batch: dirty OSD lines, the progress
+        // overlay, and the input frame all pack into one framed DMA
+        // transaction under a single chip select at the flush below
+        spiFpga.batchBegin();
+
+        // Update menu (handles timeout)
+        osdMenu.update();
+
+        // Detect toggle flips; NVS commit is coalesced internally
+        settingsStore.update();
+
+        // Check visibility change
+        if (osdMenu.isVisible() != lastVisible) {
+            lastVisible = osdMenu.isVisible();
+            sendOSDVisibility(lastVisible);
+        }
+
+        // Render and send changed lines at 30 fps max
+        if (osdMenu.isVisible() && (millis() - lastRender > RENDER_PERIOD_MS)) {
+            if (osdMenu.renderDirty(osdBuffer)) {
+                uint8_t lineStart, numLines;
+                osdMenu.getDirtySpan(lineStart, numLines);
+                if (numLines >= OSD_LINES) {
+                    sendOSDBuffer();  // Full frame changed, bulk DMA path
+                } else {
+                    // Joins the tick batch, shipped at the flush below
+                    spiFpga.batchOsdLines(osdBuffer, lineStart, numLines);
+                }
+            }
+            lastRender = millis();
+        }
+
+        // Transfer progress overlay: drawn here, never by the transfer
+        // task, so the bus still has a single master. Two OSD lines at
+        // ~5 Hz rides between the transfer's chunk transactions.
+        if (fileTransfer.isActive()) {
+            uint32_t now = millis();
+            if (!progressShown ||
+                now - lastProgressMs >= PROGRESS_PERIOD_MS) {
+                uint32_t bytes = fileTransfer.getBytesTransferred();
+
+                // Counter restarts when the queue moves to the next
+                // file; skip the rate sample across that boundary
+                uint32_t kbPerS = 0;
+                if (progressShown && now > lastProgressMs &&
+                    bytes >= lastProgressBytes) {
+                    kbPerS = ((bytes - lastProgressBytes) * 1000UL) /
+                             ((now - lastProgressMs) * 1024UL);
+                }
+
+                if (!progressShown && !osdMenu.isVisible()) {
+                    sendOSDVisibility(true);  // Overlay only, no menu
+                }
+
+                osdMenu.renderTransferProgress(osdBuffer,
+                                               fileTransfer.getFilename(),
+                                               fileTransfer.getProgress(),
+                                               kbPerS);
+                spiFpga.batchOsdLines(osdBuffer, OSD_LINES - 2, 2);
+
+                progressShown = true;
+                lastProgressMs = now;
+                lastProgressBytes = bytes;
+            }
+        } else if (progressShown) {
+            progressShown = false;
+            if (osdMenu.isVisible()) {
+                // Repaint the menu over the overlay region
+                osdMenu.setVisible(true);
+            } else {
+                sendOSDVisibility(false);
+            }
+        }
+
+        // Ship joystick/status changes as one coalesced frame per tick
+        // (skipped entirely while the controls are idle)
+        spiFpga.flushInputFrame();
+
+        // One CS session per tick: everything batched above goes out as
+        // a single queued transaction; an empty batch costs nothing
+        spiFpga.batchFlush();
+
+        // Reap any completed queued SPI transactions
+        spiFpga.pollAsync();
+
+        // Serial query interface: 'p' dumps probe stats, 'x' resets
+        if (Serial.available()) {
+            int c = Serial.read();
+            if (c == 'p') {
+                perfProbe.dump();
+            } else if (c == 'x') {
+                perfProbe.reset();
+                Serial.println("Perf counters reset");
+            }
+        }
+
+        perfProbe.record(PERF_TICK, perfCycles() - tickStart);
+    }
 }
 
 // ============================================================================
@@ -158,22 +390,97 @@ void setup() {
     Serial.begin(115200);
     Serial.println("\n=== PDP-1 Emulator OSD Controller ===");
 
-    // Initialize GPIO
-    pinMode(PIN_OSD_IRQ, INPUT);
-    pinMode(PIN_ESP_READY, OUTPUT);
-    digitalWrite(PIN_ESP_READY, LOW);
+    // Background log drain: hot paths log into a ring, never the UART
+    ringLog.init();
+
+    // Restore persisted settings first: NVS only, no hardware behind
+    // it, and the status word must be ready the moment the link is
+    settingsStore.registerBool("aspect", &settingAspectWide,
+                               STATUS_BIT_ASPECT_WIDE);
+    settingsStore.registerBool("hwmul", &settingHwMultiply,
+                               STATUS_BIT_HW_MULTIPLY);
+    settingsStore.registerBool("varbr", &settingVarBrightness,
+                               STATUS_BIT_VAR_BRIGHTNESS);
+    settingsStore.registerBool("crtwait", &settingCrtWait,
+                               STATUS_BIT_CRT_WAIT);
+    settingsStore.init();
+
+    // SD probe on the other core, overlapping SPI link training below
+    s_sdReadySem = xSemaphoreCreateBinary();
+    xTaskCreatePinnedToCore(sdInitTask, "sd_init", SD_INIT_TASK_STACK,
+                            nullptr, SD_INIT_TASK_PRIO, nullptr, 0);
+
+    // Initialize SPI driver (also configures handshake GPIOs)
+    if (!spiFpga.init()) {
+        Serial.println("SPI FPGA driver init failed!");
+    } else {
+        Serial.println("SPI initialized");
+    }
+
+    // DMA-capable framebuffer: frame uploads are zero-copy
+    osdBuffer = spiFpga.acquireDmaBuffer(OSD_BUFFER_SIZE);
+    if (!osdBuffer) {
+        Serial.println("OSD framebuffer allocation failed!");
+    }
 
-    // Initialize SPI
-    initSPI();
-    Serial.println("SPI initialized");
+    // Configure the core in one combined status transaction before it
+    // starts running
+    settingsStore.applyToFpga();
+    spiFpga.flushInputFrame();
 
     // Initialize menu system
     osdMenu.begin(&rootMenu);
+    osdMenu.setFileSelectedCallback(onFileSelected);
     Serial.println("Menu system initialized");
 
+    // Streaming task and its wake semaphore exist before anything can
+    // enqueue (render task file select, autoboot below)
+    if (!fileTransfer.init()) {
+        Serial.println("File transfer init failed!");
+    }
+
+    // Create event queues
+    s_inputQueue = xQueueCreate(INPUT_QUEUE_LEN, sizeof(InputEvent));
+    s_navQueue = xQueueCreate(NAV_QUEUE_LEN, sizeof(InputEvent));
+
+    // Auto-repeat timer for held direction keys
+    esp_timer_create_args_t repeatArgs = {};
+    repeatArgs.callback = repeatTimerCb;
+    repeatArgs.name = "nav_repeat";
+    esp_timer_create(&repeatArgs, &s_repeatTimer);
+
+    // Input task on core 0 (protocol CPU), render/SPI on core 1 (app CPU)
+    xTaskCreatePinnedToCore(inputTask, "osd_input", INPUT_TASK_STACK,
+                            nullptr, INPUT_TASK_PRIO, &s_inputTask, 0);
+    xTaskCreatePinnedToCore(renderTask, "osd_render", RENDER_TASK_STACK,
+                            nullptr, RENDER_TASK_PRIO, &s_renderTask, 1);
+
+    // Interrupt-driven input: rising edge on the FPGA IRQ line
+    attachInterrupt(digitalPinToInterrupt(PIN_OSD_IRQ), osdIrqISR, RISING);
+
     // Signal ready to FPGA
     digitalWrite(PIN_ESP_READY, HIGH);
     Serial.println("ESP32 OSD Controller ready");
+
+    // Autoboot: once the SD probe lands, queue the last-used image
+    // without any menu interaction. A cold card or missing file just
+    // leaves the core at the blank CRT as before.
+    if (xSemaphoreTake(s_sdReadySem,
+                       pdMS_TO_TICKS(SD_READY_WAIT_MS)) == pdTRUE) {
+        if (!s_sdOk) {
+            Serial.println("File browser init failed (no SD card?)");
+        } else {
+            char bootPath[128];
+            uint8_t bootType;
+            if (settingsStore.getLastImage(bootPath, sizeof(bootPath),
+                                           &bootType) &&
+                SD.exists(bootPath)) {
+                Serial.printf("Autoboot: %s\n", bootPath);
+                fileTransfer.enqueueTransfer(bootPath, bootType,
+                                             TRANSFER_PRI_USER);
+            }
+        }
+    }
 }
 
 // ============================================================================
@@ -181,37 +488,6 @@ void setup() {
 // ============================================================================
 
 void loop() {
-    static bool lastVisible = false;
-    static uint32_t lastRender = 0;
-
-    // Read navigation input
-    NavCommand nav = readNavInput();
-
-    // Process navigation
-    if (nav != NAV_NONE) {
-        if (osdMenu.navigate(nav)) {
-            // Menu changed, force re-render
-            lastRender = 0;
-        }
-    }
-
-    // Update menu (handles timeout)
-    osdMenu.update();
-
-    // Check visibility change
-    if (osdMenu.isVisible() != lastVisible) {
-        lastVisible = osdMenu.isVisible();
-        sendOSDVisibility(lastVisible);
-        lastRender = 0;  // Force render on visibility change
-    }
-
-    // Render and send buffer at 30 fps max
-    if (osdMenu.isVisible() && (millis() - lastRender > 33)) {
-        osdMenu.render(osdBuffer);
-        sendOSDBuffer();
-        lastRender = millis();
-    }
-
-    // Small delay to prevent busy loop
-    delay(1);
+    // All work happens in the pinned tasks; retire the Arduino loop task
+    vTaskDelete(nullptr);
 }
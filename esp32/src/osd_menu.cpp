@@ -7,6 +7,8 @@
  */
 
 #include "osd_menu.h"
+#include "osd_font.h"
+#include "perf_probe.h"
 #include <string.h>
 
 // ============================================================================
@@ -15,7 +17,25 @@
 
 OSDMenu::OSDMenu() {
     memset(&state, 0, sizeof(MenuState));
-    initFont();
+    dirtyLines = 0;
+    lastMenu = nullptr;
+    lastSelected = 0;
+    lastScroll = 0;
+    lastRenderValid = false;
+    selectedRowDirty = false;
+    memset(strips, 0, sizeof(strips));
+    stripClock = 0;
+    browserActive = false;
+    browserItem = nullptr;
+    fileSelectedCb = nullptr;
+    browserSelected = 0;
+    browserScroll = 0;
+    browserTotal = 0;
+    browserWindowOffset = 0;
+    browserWindowCount = 0;
+    lastBrowserSelected = 0;
+    lastBrowserScroll = 0;
+    browserViewValid = false;
 }
 
 // ============================================================================
@@ -37,120 +57,6 @@ void OSDMenu::begin(MenuItem* rootMenu) {
     }
 }
 
-// ============================================================================
-// Font Initialization (Basic 8x8 ASCII font)
-// ============================================================================
-
-void OSDMenu::initFont() {
-    // Initialize with zeros
-    memset(font8x8, 0, sizeof(font8x8));
-
-    // Space (32)
-    // Already zero
-
-    // Letters A-Z (65-90)
-    const uint8_t letters[][8] = {
-        // A
-        {0x18, 0x3C, 0x66, 0x66, 0x7E, 0x66, 0x66, 0x00},
-        // B
-        {0x7C, 0x66, 0x66, 0x7C, 0x66, 0x66, 0x7C, 0x00},
-        // C
-        {0x3C, 0x66, 0x60, 0x60, 0x60, 0x66, 0x3C, 0x00},
-        // D
-        {0x78, 0x6C, 0x66, 0x66, 0x66, 0x6C, 0x78, 0x00},
-        // E
-        {0x7E, 0x60, 0x60, 0x7C, 0x60, 0x60, 0x7E, 0x00},
-        // F
-        {0x7E, 0x60, 0x60, 0x7C, 0x60, 0x60, 0x60, 0x00},
-        // G
-        {0x3C, 0x66, 0x60, 0x6E, 0x66, 0x66, 0x3E, 0x00},
-        // H
-        {0x66, 0x66, 0x66, 0x7E, 0x66, 0x66, 0x66, 0x00},
-        // I
-        {0x3C, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C, 0x00},
-        // J
-        {0x1E, 0x0C, 0x0C, 0x0C, 0x6C, 0x6C, 0x38, 0x00},
-        // K
-        {0x66, 0x6C, 0x78, 0x70, 0x78, 0x6C, 0x66, 0x00},
-        // L
-        {0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x7E, 0x00},
-        // M
-        {0x63, 0x77, 0x7F, 0x6B, 0x63, 0x63, 0x63, 0x00},
-        // N
-        {0x66, 0x76, 0x7E, 0x7E, 0x6E, 0x66, 0x66, 0x00},
-        // O
-        {0x3C, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C, 0x00},
-        // P
-        {0x7C, 0x66, 0x66, 0x7C, 0x60, 0x60, 0x60, 0x00},
-        // Q
-        {0x3C, 0x66, 0x66, 0x66, 0x6A, 0x6C, 0x36, 0x00},
-        // R
-        {0x7C, 0x66, 0x66, 0x7C, 0x6C, 0x66, 0x66, 0x00},
-        // S
-        {0x3C, 0x66, 0x60, 0x3C, 0x06, 0x66, 0x3C, 0x00},
-        // T
-        {0x7E, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00},
-        // U
-        {0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x3C, 0x00},
-        // V
-        {0x66, 0x66, 0x66, 0x66, 0x66, 0x3C, 0x18, 0x00},
-        // W
-        {0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00},
-        // X
-        {0x66, 0x66, 0x3C, 0x18, 0x3C, 0x66, 0x66, 0x00},
-        // Y
-        {0x66, 0x66, 0x66, 0x3C, 0x18, 0x18, 0x18, 0x00},
-        // Z
-        {0x7E, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x7E, 0x00}
-    };
-
-    for (int i = 0; i < 26; i++) {
-        memcpy(font8x8['A' - 32 + i], letters[i], 8);
-        // Lowercase (same as uppercase for simplicity)
-        memcpy(font8x8['a' - 32 + i], letters[i], 8);
-    }
-
-    // Numbers 0-9 (48-57)
-    const uint8_t numbers[][8] = {
-        {0x3C, 0x66, 0x6E, 0x76, 0x66, 0x66, 0x3C, 0x00}, // 0
-        {0x18, 0x38, 0x18, 0x18, 0x18, 0x18, 0x7E, 0x00}, // 1
-        {0x3C, 0x66, 0x06, 0x0C, 0x18, 0x30, 0x7E, 0x00}, // 2
-        {0x3C, 0x66, 0x06, 0x1C, 0x06, 0x66, 0x3C, 0x00}, // 3
-        {0x0C, 0x1C, 0x3C, 0x6C, 0x7E, 0x0C, 0x0C, 0x00}, // 4
-        {0x7E, 0x60, 0x7C, 0x06, 0x06, 0x66, 0x3C, 0x00}, // 5
-        {0x1C, 0x30, 0x60, 0x7C, 0x66, 0x66, 0x3C, 0x00}, // 6
-        {0x7E, 0x06, 0x0C, 0x18, 0x30, 0x30, 0x30, 0x00}, // 7
-        {0x3C, 0x66, 0x66, 0x3C, 0x66, 0x66, 0x3C, 0x00}, // 8
-        {0x3C, 0x66, 0x66, 0x3E, 0x06, 0x0C, 0x38, 0x00}  // 9
-    };
-
-    for (int i = 0; i < 10; i++) {
-        memcpy(font8x8['0' - 32 + i], numbers[i], 8);
-    }
-
-    // Special characters
-    const uint8_t colon[] = {0x00, 0x18, 0x18, 0x00, 0x18, 0x18, 0x00, 0x00};
-    memcpy(font8x8[':' - 32], colon, 8);
-
-    const uint8_t period[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00};
-    memcpy(font8x8['.' - 32], period, 8);
-
-    const uint8_t hyphen[] = {0x00, 0x00, 0x00, 0x7E, 0x00, 0x00, 0x00, 0x00};
-    memcpy(font8x8['-' - 32], hyphen, 8);
-
-    const uint8_t lbracket[] = {0x3C, 0x30, 0x30, 0x30, 0x30, 0x30, 0x3C, 0x00};
-    memcpy(font8x8['[' - 32], lbracket, 8);
-
-    const uint8_t rbracket[] = {0x3C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x3C, 0x00};
-    memcpy(font8x8[']' - 32], rbracket, 8);
-
-    const uint8_t slash[] = {0x06, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0x80, 0x00};
-    memcpy(font8x8['/' - 32], slash, 8);
-
-    const uint8_t arrow[] = {0x00, 0x18, 0x0C, 0xFE, 0x0C, 0x18, 0x00, 0x00};
-    memcpy(font8x8['>' - 32], arrow, 8);
-}
-
 // ============================================================================
 // Navigation
 // ============================================================================
@@ -161,6 +67,12 @@ bool OSDMenu::navigate(NavCommand cmd) {
     }
 
     state.lastActivity = millis();
+
+    // Browser view is modal: it consumes all navigation while active
+    if (browserActive) {
+        return browserNavigate(cmd);
+    }
+
     bool changed = false;
 
     switch (cmd) {
@@ -277,18 +189,19 @@ void OSDMenu::activateItem() {
             if (item->toggle.value) {
                 *(item->toggle.value) = !*(item->toggle.value);
             }
+            // Selection did not move, but the row's value text did
+            selectedRowDirty = true;
             break;
 
         case ITEM_TRIGGER:
             if (item->trigger.action) {
                 item->trigger.action(item);
             }
+            selectedRowDirty = true;
             break;
 
         case ITEM_FILE_SELECT:
-            if (item->trigger.action) {
-                item->trigger.action(item);
-            }
+            openBrowser(item);
             break;
 
         default:
@@ -300,6 +213,54 @@ void OSDMenu::activateItem() {
 // Rendering
 // ============================================================================
 
+// Menu layout constants (shared by full and partial rendering)
+static const int kMenuStartY = 16;
+static const int kMenuItemHeight = 11;
+static const int kMenuMaxVisible = 10;
+
+void OSDMenu::drawItemRow(uint8_t* buffer, int itemIndex) {
+    MenuItem* items = state.current->submenu.items;
+    MenuItem* item = &items[itemIndex];
+    int y = kMenuStartY + (itemIndex - state.scrollOffset) * kMenuItemHeight;
+    bool selected = (itemIndex == state.selectedIndex);
+
+    if (selected) {
+        drawFilledRect(buffer, 0, y, OSD_WIDTH, kMenuItemHeight);
+    }
+
+    if (item->type == ITEM_SEPARATOR) {
+        // Draw separator line
+        drawHLine(buffer, 8, y + 5, OSD_WIDTH - 16);
+    } else {
+        // Draw selection indicator
+        if (selected) {
+            drawCachedString(buffer, 4, y + 2, ">", true);
+        }
+
+        // Draw label
+        drawCachedString(buffer, 16, y + 2, item->label, selected);
+
+        // Draw value for toggles ("[Yes]"/"[No]" cached as separate
+        // bracketed fragments keyed on the inner text)
+        if (item->type == ITEM_TOGGLE && item->toggle.value) {
+            const char* valStr = *(item->toggle.value) ?
+                item->toggle.onText : item->toggle.offText;
+            int valX = OSD_WIDTH - (strlen(valStr) + 2) * 8 - 8;
+            drawCachedString(buffer, valX, y + 2, valStr, selected, true);
+        }
+
+        // Draw submenu indicator
+        if (item->type == ITEM_SUBMENU) {
+            drawCachedString(buffer, OSD_WIDTH - 16, y + 2, ">", selected);
+        }
+
+        // Draw file select indicator
+        if (item->type == ITEM_FILE_SELECT) {
+            drawCachedString(buffer, OSD_WIDTH - 24, y + 2, "...", selected);
+        }
+    }
+}
+
 void OSDMenu::render(uint8_t* buffer) {
     clearBuffer(buffer);
 
@@ -308,81 +269,538 @@ void OSDMenu::render(uint8_t* buffer) {
     }
 
     MenuItem* menu = state.current;
-    MenuItem* items = menu->submenu.items;
     uint8_t count = menu->submenu.count;
 
     // Draw title bar
     drawFilledRect(buffer, 0, 0, OSD_WIDTH, 12);
     const char* title = menu->label ? menu->label : "PDP-1 Emulator";
-    drawString(buffer, 4, 2, title, true);
+    drawCachedString(buffer, 4, 2, title, true);
 
     // Draw menu items
-    const int startY = 16;
-    const int itemHeight = 11;
-    const int maxVisible = 10;
+    for (int i = 0; i < kMenuMaxVisible && (i + state.scrollOffset) < count; i++) {
+        drawItemRow(buffer, i + state.scrollOffset);
+    }
 
-    for (int i = 0; i < maxVisible && (i + state.scrollOffset) < count; i++) {
-        int itemIndex = i + state.scrollOffset;
-        MenuItem* item = &items[itemIndex];
-        int y = startY + i * itemHeight;
-        bool selected = (itemIndex == state.selectedIndex);
+    // Draw scroll indicators if needed
+    if (state.scrollOffset > 0) {
+        drawCachedString(buffer, OSD_WIDTH - 16, kMenuStartY, "^", false);
+    }
+    if (state.scrollOffset + kMenuMaxVisible < count) {
+        drawCachedString(buffer, OSD_WIDTH - 16,
+                         kMenuStartY + (kMenuMaxVisible - 1) * kMenuItemHeight,
+                         "v", false);
+    }
 
-        if (selected) {
-            drawFilledRect(buffer, 0, y, OSD_WIDTH, itemHeight);
-        }
+    // Draw border
+    drawRect(buffer, 0, 0, OSD_WIDTH, OSD_HEIGHT);
 
-        if (item->type == ITEM_SEPARATOR) {
-            // Draw separator line
-            drawHLine(buffer, 8, y + 5, OSD_WIDTH - 16);
-        } else {
-            // Draw selection indicator
-            if (selected) {
-                drawString(buffer, 4, y + 2, ">", true);
-            }
+    // Record rendered state for partial updates
+    lastMenu = state.current;
+    lastSelected = state.selectedIndex;
+    lastScroll = state.scrollOffset;
+    lastRenderValid = true;
+    selectedRowDirty = false;
+}
+
+bool OSDMenu::renderDirty(uint8_t* buffer) {
+    PERF_SCOPE(PERF_RENDER);
+    if (!state.visible || !state.current) {
+        return false;
+    }
+
+    if (browserActive) {
+        renderBrowserDirty(buffer);
+        return dirtyLines != 0;
+    }
+
+    // Structural change: menu level, scroll position, or stale buffer
+    if (!lastRenderValid || state.current != lastMenu ||
+        state.scrollOffset != lastScroll) {
+        render(buffer);
+        return dirtyLines != 0;
+    }
+
+    // Selection moved within the visible window: redraw the two rows
+    if (state.selectedIndex != lastSelected) {
+        uint8_t oldIndex = lastSelected;
+
+        int oldY = kMenuStartY + (oldIndex - state.scrollOffset) * kMenuItemHeight;
+        int newY = kMenuStartY + (state.selectedIndex - state.scrollOffset) * kMenuItemHeight;
+
+        clearRect(buffer, 1, oldY, OSD_WIDTH - 2, kMenuItemHeight);
+        clearRect(buffer, 1, newY, OSD_WIDTH - 2, kMenuItemHeight);
+        drawItemRow(buffer, oldIndex);
+        drawItemRow(buffer, state.selectedIndex);
+
+        lastSelected = state.selectedIndex;
+        selectedRowDirty = false;
+    }
+
+    // Activation changed the selected row in place (toggle value text):
+    // repaint just that row, same as the selection-move path
+    if (selectedRowDirty) {
+        int y = kMenuStartY +
+                (state.selectedIndex - state.scrollOffset) * kMenuItemHeight;
+        clearRect(buffer, 1, y, OSD_WIDTH - 2, kMenuItemHeight);
+        drawItemRow(buffer, state.selectedIndex);
+        selectedRowDirty = false;
+    }
+
+    return dirtyLines != 0;
+}
+
+bool OSDMenu::getDirtySpan(uint8_t& lineStart, uint8_t& numLines) {
+    if (dirtyLines == 0) {
+        lineStart = 0;
+        numLines = 0;
+        return false;
+    }
+
+    uint8_t first = 0;
+    while (!(dirtyLines & (1 << first))) first++;
+
+    uint8_t last = OSD_LINES - 1;
+    while (!(dirtyLines & (1 << last))) last--;
+
+    lineStart = first;
+    numLines = last - first + 1;
+    dirtyLines = 0;
+    return true;
+}
+
+// ============================================================================
+// File Browser View
+// ============================================================================
+
+void OSDMenu::openBrowser(MenuItem* item) {
+    browserItem = item;
+
+    // Menu extensions use the ".bin" form; the browser filter takes the
+    // bare comma-list form
+    const char* ext = item->fileSelect.extension;
+    if (ext && ext[0] == '.') {
+        ext++;
+    }
+    fileBrowser.setFilter(ext);
+
+    if (fileBrowser.getCurrentPath()[0] == '\0') {
+        fileBrowser.setDirectory("/");
+    }
+
+    browserActive = true;
+    resetBrowserListing();
+}
+
+void OSDMenu::closeBrowser() {
+    browserActive = false;
+    lastRenderValid = false;  // Menu underneath needs a full repaint
+}
+
+void OSDMenu::resetBrowserListing() {
+    browserSelected = 0;
+    browserScroll = 0;
+    browserWindowOffset = 0;
+    browserWindowCount = 0;
+    fetchBrowserWindow();
+    browserViewValid = false;
+}
+
+/**
+ * Fetch the listing window anchored a few entries above the visible
+ * rows, so short scrolls in either direction stay inside the local
+ * copy without touching FileBrowser at all.
+ */
+void OSDMenu::fetchBrowserWindow() {
+    const size_t margin =
+        (FileBrowser::WINDOW_CAPACITY - kMenuMaxVisible) / 2;
+    size_t offset = (browserScroll > margin) ? browserScroll - margin : 0;
+
+    const FileEntry* window = nullptr;
+    size_t n = fileBrowser.scanWindow(offset, FileBrowser::WINDOW_CAPACITY,
+                                      &window);
+
+    // Copy out: the FileBrowser pool is invalidated by its next scan
+    for (size_t i = 0; i < n; i++) {
+        browserWindow[i] = window[i];
+    }
+    browserWindowOffset = offset;
+    browserWindowCount = n;
+    browserTotal = fileBrowser.getTotalCount();
+}
+
+const FileEntry* OSDMenu::browserEntryAt(size_t index) {
+    if (index < browserWindowOffset ||
+        index >= browserWindowOffset + browserWindowCount) {
+        return nullptr;
+    }
+    return &browserWindow[index - browserWindowOffset];
+}
+
+bool OSDMenu::browserNavigate(NavCommand cmd) {
+    bool changed = false;
 
-            // Draw label
-            drawString(buffer, 16, y + 2, item->label, selected);
-
-            // Draw value for toggles
-            if (item->type == ITEM_TOGGLE && item->toggle.value) {
-                const char* valStr = *(item->toggle.value) ?
-                    item->toggle.onText : item->toggle.offText;
-                char valBuf[32];
-                snprintf(valBuf, sizeof(valBuf), "[%s]", valStr);
-                int valX = OSD_WIDTH - strlen(valBuf) * 8 - 8;
-                drawString(buffer, valX, y + 2, valBuf, selected);
+    switch (cmd) {
+        case NAV_UP:
+            if (browserSelected > 0) {
+                browserSelected--;
+                changed = true;
             }
+            break;
 
-            // Draw submenu indicator
-            if (item->type == ITEM_SUBMENU) {
-                drawString(buffer, OSD_WIDTH - 16, y + 2, ">", selected);
+        case NAV_DOWN:
+            if (browserSelected + 1 < browserTotal) {
+                browserSelected++;
+                changed = true;
             }
+            break;
 
-            // Draw file select indicator
-            if (item->type == ITEM_FILE_SELECT) {
-                drawString(buffer, OSD_WIDTH - 24, y + 2, "...", selected);
+        case NAV_RIGHT:
+        case NAV_SELECT:
+            browserActivate();
+            changed = true;
+            break;
+
+        case NAV_LEFT:
+            // One level up; leaving the root closes the browser
+            if (fileBrowser.navigateUp()) {
+                resetBrowserListing();
+            } else {
+                closeBrowser();
             }
+            changed = true;
+            break;
+
+        case NAV_BACK:
+            closeBrowser();
+            changed = true;
+            break;
+
+        default:
+            break;
+    }
+
+    if (!browserActive) {
+        return changed;
+    }
+
+    // Keep the selection inside the visible rows
+    if (browserSelected < browserScroll) {
+        browserScroll = browserSelected;
+    } else if (browserSelected >= browserScroll + kMenuMaxVisible) {
+        browserScroll = browserSelected - kMenuMaxVisible + 1;
+    }
+
+    // Fallback fetch: only needed if a jump outran the prefetched
+    // window (the steady-scroll case is covered by renderBrowserDirty)
+    size_t visibleEnd = browserScroll + kMenuMaxVisible;
+    if (visibleEnd > browserTotal) {
+        visibleEnd = browserTotal;
+    }
+    if (browserScroll < browserWindowOffset ||
+        visibleEnd > browserWindowOffset + browserWindowCount) {
+        fetchBrowserWindow();
+    }
+
+    return changed;
+}
+
+void OSDMenu::browserActivate() {
+    const FileEntry* entry = browserEntryAt(browserSelected);
+    if (!entry) {
+        return;
+    }
+
+    if (entry->isDirectory) {
+        // navigateInto resolves ".." entries to navigateUp itself
+        if (fileBrowser.navigateInto(browserSelected)) {
+            resetBrowserListing();
         }
+        return;
     }
 
-    // Draw scroll indicators if needed
-    if (state.scrollOffset > 0) {
-        drawString(buffer, OSD_WIDTH - 16, startY, "^", false);
+    // Compose the full path into the item's buffer and hand off.
+    // The current path keeps its trailing slash, so plain
+    // concatenation is correct at the root as well.
+    MenuItem* item = browserItem;
+    if (item && item->fileSelect.selectedPath) {
+        snprintf(item->fileSelect.selectedPath, item->fileSelect.pathSize,
+                 "%s%s", fileBrowser.getCurrentPath(), entry->name);
     }
-    if (state.scrollOffset + maxVisible < count) {
-        drawString(buffer, OSD_WIDTH - 16, startY + (maxVisible - 1) * itemHeight, "v", false);
+
+    closeBrowser();
+
+    if (fileSelectedCb && item) {
+        fileSelectedCb(item, item->fileSelect.selectedPath);
+    }
+}
+
+// Right-aligned size column: "512B", "37K", "2M"
+static void formatEntrySize(uint32_t size, char* out, size_t outSize) {
+    if (size < 1024) {
+        snprintf(out, outSize, "%luB", (unsigned long)size);
+    } else if (size < 1024UL * 1024UL) {
+        snprintf(out, outSize, "%luK", (unsigned long)(size / 1024));
+    } else {
+        snprintf(out, outSize, "%luM", (unsigned long)(size / (1024UL * 1024UL)));
+    }
+}
+
+void OSDMenu::drawBrowserRow(uint8_t* buffer, size_t absIndex) {
+    const FileEntry* entry = browserEntryAt(absIndex);
+    if (!entry) {
+        return;
+    }
+
+    int y = kMenuStartY + (int)(absIndex - browserScroll) * kMenuItemHeight;
+    bool selected = (absIndex == browserSelected);
+
+    if (selected) {
+        drawFilledRect(buffer, 0, y, OSD_WIDTH, kMenuItemHeight);
+        drawCachedString(buffer, 4, y + 2, ">", true);
+    }
+
+    // Filenames come from the window pool and change under refetch, so
+    // they bypass the pointer-keyed strip cache. Truncate so the name
+    // never runs into the size column.
+    char name[MAX_LABEL_LEN + 1];
+    snprintf(name, sizeof(name), "%s", entry->name);
+    drawString(buffer, 16, y + 2, name, selected);
+
+    if (entry->isDirectory) {
+        drawCachedString(buffer, OSD_WIDTH - 48, y + 2, "<DIR>", selected);
+    } else {
+        char sizeStr[8];
+        formatEntrySize(entry->size, sizeStr, sizeof(sizeStr));
+        int sx = OSD_WIDTH - (int)strlen(sizeStr) * 8 - 8;
+        drawString(buffer, sx, y + 2, sizeStr, selected);
+    }
+}
+
+void OSDMenu::renderBrowser(uint8_t* buffer) {
+    clearBuffer(buffer);
+
+    // Title bar shows the current directory
+    drawFilledRect(buffer, 0, 0, OSD_WIDTH, 12);
+    drawString(buffer, 4, 2, fileBrowser.getCurrentPath(), true);
+
+    if (browserTotal == 0) {
+        drawString(buffer, 16, kMenuStartY + 2, "(no files)", false);
+    }
+
+    for (int i = 0; i < kMenuMaxVisible &&
+                    (browserScroll + i) < browserTotal; i++) {
+        drawBrowserRow(buffer, browserScroll + i);
+    }
+
+    if (browserScroll > 0) {
+        drawCachedString(buffer, OSD_WIDTH - 16, kMenuStartY, "^", false);
+    }
+    if (browserScroll + kMenuMaxVisible < browserTotal) {
+        drawCachedString(buffer, OSD_WIDTH - 16,
+                         kMenuStartY + (kMenuMaxVisible - 1) * kMenuItemHeight,
+                         "v", false);
     }
 
-    // Draw border
     drawRect(buffer, 0, 0, OSD_WIDTH, OSD_HEIGHT);
+
+    lastBrowserSelected = browserSelected;
+    lastBrowserScroll = browserScroll;
+    browserViewValid = true;
+}
+
+/**
+ * One-step scroll: shift the item region by one row height in the
+ * framebuffer and rasterize only the row that scrolled into view, the
+ * row the selection highlight left, and the edge rows where the
+ * scroll indicators toggle. Every shifted line still transmits, but
+ * ten rows of text rasterization collapse to at most four.
+ */
+void OSDMenu::scrollBrowserRows(int direction, uint8_t* buffer) {
+    const int stride = OSD_WIDTH / 8;
+    const int regionRows = kMenuMaxVisible * kMenuItemHeight;
+    uint8_t* region = buffer + kMenuStartY * stride;
+    const size_t shiftBytes = (size_t)kMenuItemHeight * stride;
+    const size_t keepBytes = (size_t)(regionRows - kMenuItemHeight) * stride;
+
+    if (direction > 0) {
+        // Scrolled down: rows move up, fresh row appears at the bottom
+        memmove(region, region + shiftBytes, keepBytes);
+    } else {
+        memmove(region + shiftBytes, region, keepBytes);
+    }
+    markDirtyRows(kMenuStartY, regionRows);
+
+    // Rows needing fresh pixels (duplicates skipped)
+    size_t rows[4] = {
+        browserScroll,                          // top (indicator edge)
+        browserScroll + kMenuMaxVisible - 1,    // bottom (incoming row)
+        lastBrowserSelected,                    // stale highlight
+        browserSelected
+    };
+
+    for (int i = 0; i < 4; i++) {
+        size_t row = rows[i];
+        if (row >= browserTotal ||
+            row < browserScroll ||
+            row >= browserScroll + kMenuMaxVisible) {
+            continue;
+        }
+        bool dup = false;
+        for (int j = 0; j < i; j++) {
+            if (rows[j] == row) dup = true;
+        }
+        if (dup) {
+            continue;
+        }
+        int y = kMenuStartY + (int)(row - browserScroll) * kMenuItemHeight;
+        clearRect(buffer, 1, y, OSD_WIDTH - 2, kMenuItemHeight);
+        drawBrowserRow(buffer, row);
+    }
+
+    // Scroll indicators live inside the edge rows just redrawn
+    if (browserScroll > 0) {
+        drawCachedString(buffer, OSD_WIDTH - 16, kMenuStartY, "^", false);
+    }
+    if (browserScroll + kMenuMaxVisible < browserTotal) {
+        drawCachedString(buffer, OSD_WIDTH - 16,
+                         kMenuStartY + (kMenuMaxVisible - 1) * kMenuItemHeight,
+                         "v", false);
+    }
+}
+
+void OSDMenu::renderBrowserDirty(uint8_t* buffer) {
+    if (!browserViewValid) {
+        renderBrowser(buffer);
+        return;
+    }
+
+    long delta = (long)browserScroll - (long)lastBrowserScroll;
+
+    if (delta == 1 || delta == -1) {
+        // The held-key case: shift instead of re-rasterizing all rows
+        scrollBrowserRows((int)delta, buffer);
+        lastBrowserScroll = browserScroll;
+        lastBrowserSelected = browserSelected;
+    } else if (delta != 0) {
+        renderBrowser(buffer);
+    } else if (browserSelected != lastBrowserSelected) {
+        // Selection moved within the visible window: two rows redraw,
+        // two OSD lines transmit
+        size_t oldIndex = lastBrowserSelected;
+        int oldY = kMenuStartY +
+                   (int)(oldIndex - browserScroll) * kMenuItemHeight;
+        int newY = kMenuStartY +
+                   (int)(browserSelected - browserScroll) * kMenuItemHeight;
+
+        clearRect(buffer, 1, oldY, OSD_WIDTH - 2, kMenuItemHeight);
+        clearRect(buffer, 1, newY, OSD_WIDTH - 2, kMenuItemHeight);
+        drawBrowserRow(buffer, oldIndex);
+        drawBrowserRow(buffer, browserSelected);
+
+        lastBrowserSelected = browserSelected;
+    }
+
+    // Prefetch: once the visible rows drift near the window edge,
+    // re-anchor it now that the frame content is already composed, so
+    // the next scroll step never waits on the SD path before rendering
+    size_t marginAbove = browserScroll - browserWindowOffset;
+    size_t marginBelow =
+        (browserWindowOffset + browserWindowCount) -
+        (browserScroll + kMenuMaxVisible < browserTotal ?
+         browserScroll + kMenuMaxVisible : browserTotal);
+    if ((marginBelow < 2 &&
+         browserWindowOffset + browserWindowCount < browserTotal) ||
+        (marginAbove < 2 && browserWindowOffset > 0)) {
+        fetchBrowserWindow();
+    }
+}
+
+// ============================================================================
+// Transfer Progress Overlay
+// ============================================================================
+
+/**
+ * Filename left, throughput right, bar underneath - confined to the
+ * bottom two OSD lines so the render task can transmit the region
+ * with one partial-line transfer between chunk boundaries.
+ */
+void OSDMenu::renderTransferProgress(uint8_t* buffer, const char* name,
+                                     uint8_t percent, uint32_t kbPerS) {
+    const int y = OSD_HEIGHT - 2 * OSD_LINE_HEIGHT;
+
+    clearRect(buffer, 0, y, OSD_WIDTH, 2 * OSD_LINE_HEIGHT);
+
+    // Both strings are dynamic, so they bypass the strip cache
+    drawString(buffer, 4, y, name, false);
+
+    char rate[16];
+    snprintf(rate, sizeof(rate), "%luKB/s", (unsigned long)kbPerS);
+    drawString(buffer, OSD_WIDTH - (int)strlen(rate) * 8 - 4, y, rate,
+               false);
+
+    // Bar outline with proportional fill
+    const int barY = y + OSD_LINE_HEIGHT + 1;
+    const int barW = OSD_WIDTH - 8;
+    if (percent > 100) {
+        percent = 100;
+    }
+    drawRect(buffer, 4, barY, barW, 6);
+    int fill = (int)(((uint32_t)(barW - 2) * percent) / 100);
+    if (fill > 0) {
+        drawFilledRect(buffer, 5, barY + 1, fill, 4);
+    }
 }
 
 // ============================================================================
 // Drawing Primitives
 // ============================================================================
 
+void OSDMenu::markDirtyRows(int y, int h) {
+    if (h <= 0) return;
+
+    int first = y / OSD_LINE_HEIGHT;
+    int last = (y + h - 1) / OSD_LINE_HEIGHT;
+    if (first < 0) first = 0;
+    if (last >= OSD_LINES) last = OSD_LINES - 1;
+
+    for (int line = first; line <= last; line++) {
+        dirtyLines |= (1 << line);
+    }
+}
+
 void OSDMenu::clearBuffer(uint8_t* buffer) {
     memset(buffer, 0, OSD_BUFFER_SIZE);
+    dirtyLines = (1 << OSD_LINES) - 1;  // Everything changed
+}
+
+void OSDMenu::clearRect(uint8_t* buffer, int x, int y, int w, int h) {
+    if (x < 0) { w += x; x = 0; }
+    if (x + w > OSD_WIDTH) w = OSD_WIDTH - x;
+    if (w <= 0 || h <= 0) return;
+
+    markDirtyRows(y, h);
+
+    const int stride = OSD_WIDTH / 8;
+    int firstByte = x / 8;
+    int lastByte = (x + w - 1) / 8;
+    uint8_t firstMask = 0xFF >> (x & 7);
+    uint8_t lastMask = (uint8_t)(0xFF << (7 - ((x + w - 1) & 7)));
+
+    for (int row = y; row < y + h && row < OSD_HEIGHT; row++) {
+        if (row < 0) continue;
+        uint8_t* line = buffer + row * stride;
+
+        if (firstByte == lastByte) {
+            line[firstByte] &= ~(firstMask & lastMask);
+            continue;
+        }
+
+        line[firstByte] &= ~firstMask;
+        if (lastByte - firstByte > 1) {
+            memset(line + firstByte + 1, 0x00, lastByte - firstByte - 1);
+        }
+        line[lastByte] &= ~lastMask;
+    }
 }
 
 void OSDMenu::drawChar(uint8_t* buffer, int x, int y, char c, bool invert) {
@@ -390,24 +808,142 @@ void OSDMenu::drawChar(uint8_t* buffer, int x, int y, char c, bool invert) {
     if (x < 0 || x >= OSD_WIDTH - 8) return;
     if (y < 0 || y >= OSD_HEIGHT - 8) return;
 
-    const uint8_t* glyph = font8x8[c - 32];
+    const uint8_t* glyph = OSD_FONT_8X8[c - 32];
+    markDirtyRows(y, 8);
+
+    // Glyphs are exactly one byte wide: blit whole bytes instead of
+    // testing 64 individual pixels
+    const int stride = OSD_WIDTH / 8;
+    uint8_t* dst = buffer + y * stride + x / 8;
+    int shift = x & 7;
+
+    if (shift == 0) {
+        // Byte-aligned: one OR per glyph row
+        for (int row = 0; row < 8; row++) {
+            uint8_t rowData = glyph[row];
+            if (invert) rowData = ~rowData;
+            *dst |= rowData;
+            dst += stride;
+        }
+    } else {
+        // Unaligned: glyph row straddles two bytes
+        for (int row = 0; row < 8; row++) {
+            uint8_t rowData = glyph[row];
+            if (invert) rowData = ~rowData;
+            dst[0] |= rowData >> shift;
+            dst[1] |= (uint8_t)(rowData << (8 - shift));
+            dst += stride;
+        }
+    }
+}
+
+// ============================================================================
+// Text Strip Cache
+// ============================================================================
+
+/**
+ * Find or rasterize the strip for (text, invert, bracketed). Keys are
+ * compared by pointer: menu text is static literal data, so equal
+ * pointers mean equal strings and the strcmp is skipped entirely.
+ */
+OSDMenu::TextStrip* OSDMenu::getStrip(const char* text, bool invert,
+                                      bool bracketed) {
+    TextStrip* victim = &strips[0];
+
+    for (size_t i = 0; i < STRIP_CACHE_SLOTS; i++) {
+        TextStrip& s = strips[i];
+        if (s.key == text && s.invert == invert &&
+            s.bracketed == bracketed) {
+            s.lastUsed = ++stripClock;
+            return &s;
+        }
+        if (!s.key) {
+            victim = &s;
+        } else if (victim->key && s.lastUsed < victim->lastUsed) {
+            victim = &s;
+        }
+    }
+
+    // Miss: rasterize into the LRU (or first free) slot, one glyph
+    // byte per character column, eight rows
+    TextStrip& s = *victim;
+    s.key = text;
+    s.invert = invert;
+    s.bracketed = bracketed;
+    s.lastUsed = ++stripClock;
+
+    char composed[STRIP_MAX_BYTES + 1];
+    const char* src = text;
+    if (bracketed) {
+        snprintf(composed, sizeof(composed), "[%s]", text);
+        src = composed;
+    }
+
+    size_t len = strlen(src);
+    if (len > STRIP_MAX_BYTES) {
+        len = STRIP_MAX_BYTES;
+    }
+    s.widthBytes = (uint8_t)len;
+
+    for (size_t col = 0; col < len; col++) {
+        char c = src[col];
+        const uint8_t* glyph =
+            (c >= 32 && c <= 127) ? OSD_FONT_8X8[c - 32] : OSD_FONT_8X8[0];
+        for (int row = 0; row < 8; row++) {
+            s.rows[row][col] = invert ? (uint8_t)~glyph[row] : glyph[row];
+        }
+    }
+
+    return &s;
+}
+
+/**
+ * Composite a cached strip into the buffer. Byte-aligned x is a plain
+ * OR loop; unaligned x shifts each strip byte across two destination
+ * bytes, same as the drawChar slow path but amortized per string.
+ */
+void OSDMenu::compositeStrip(uint8_t* buffer, int x, int y,
+                             const TextStrip* strip) {
+    if (!strip || strip->widthBytes == 0) return;
+    if (y < 0 || y >= OSD_HEIGHT - 8) return;
+    if (x < 0 || x >= OSD_WIDTH - 8) return;
+
+    int widthBytes = strip->widthBytes;
+    const int stride = OSD_WIDTH / 8;
+
+    // Clip against the right edge
+    int maxBytes = (OSD_WIDTH - x) / 8;
+    if (widthBytes > maxBytes) {
+        widthBytes = maxBytes;
+    }
+
+    markDirtyRows(y, 8);
 
+    int shift = x & 7;
     for (int row = 0; row < 8; row++) {
-        uint8_t rowData = glyph[row];
-        if (invert) rowData = ~rowData;
-
-        for (int col = 0; col < 8; col++) {
-            if (rowData & (0x80 >> col)) {
-                int px = x + col;
-                int py = y + row;
-                int byteIdx = (py * OSD_WIDTH + px) / 8;
-                int bitIdx = 7 - (px % 8);
-                buffer[byteIdx] |= (1 << bitIdx);
+        const uint8_t* srcRow = strip->rows[row];
+        uint8_t* dst = buffer + (y + row) * stride + x / 8;
+
+        if (shift == 0) {
+            for (int b = 0; b < widthBytes; b++) {
+                dst[b] |= srcRow[b];
+            }
+        } else {
+            for (int b = 0; b < widthBytes; b++) {
+                dst[b] |= srcRow[b] >> shift;
+                dst[b + 1] |= (uint8_t)(srcRow[b] << (8 - shift));
             }
         }
     }
 }
 
+void OSDMenu::drawCachedString(uint8_t* buffer, int x, int y,
+                               const char* text, bool invert,
+                               bool bracketed) {
+    if (!text) return;
+    compositeStrip(buffer, x, y, getStrip(text, invert, bracketed));
+}
+
 void OSDMenu::drawString(uint8_t* buffer, int x, int y, const char* str, bool invert) {
     if (!str) return;
 
@@ -422,18 +958,34 @@ void OSDMenu::drawString(uint8_t* buffer, int x, int y, const char* str, bool in
 
 void OSDMenu::drawHLine(uint8_t* buffer, int x, int y, int width) {
     if (y < 0 || y >= OSD_HEIGHT) return;
+    if (x < 0) { width += x; x = 0; }
+    if (x + width > OSD_WIDTH) width = OSD_WIDTH - x;
+    if (width <= 0) return;
 
-    for (int i = 0; i < width; i++) {
-        int px = x + i;
-        if (px >= 0 && px < OSD_WIDTH) {
-            int byteIdx = (y * OSD_WIDTH + px) / 8;
-            int bitIdx = 7 - (px % 8);
-            buffer[byteIdx] |= (1 << bitIdx);
-        }
+    markDirtyRows(y, 1);
+
+    // Edge bytes get partial masks, the span between is filled whole
+    uint8_t* line = buffer + y * (OSD_WIDTH / 8);
+    int firstByte = x / 8;
+    int lastByte = (x + width - 1) / 8;
+    uint8_t firstMask = 0xFF >> (x & 7);
+    uint8_t lastMask = (uint8_t)(0xFF << (7 - ((x + width - 1) & 7)));
+
+    if (firstByte == lastByte) {
+        line[firstByte] |= (firstMask & lastMask);
+        return;
+    }
+
+    line[firstByte] |= firstMask;
+    if (lastByte - firstByte > 1) {
+        memset(line + firstByte + 1, 0xFF, lastByte - firstByte - 1);
     }
+    line[lastByte] |= lastMask;
 }
 
 void OSDMenu::drawRect(uint8_t* buffer, int x, int y, int w, int h) {
+    markDirtyRows(y, h);
+
     // Top and bottom lines
     drawHLine(buffer, x, y, w);
     drawHLine(buffer, x, y + h - 1, w);
@@ -460,6 +1012,18 @@ void OSDMenu::drawRect(uint8_t* buffer, int x, int y, int w, int h) {
 }
 
 void OSDMenu::drawFilledRect(uint8_t* buffer, int x, int y, int w, int h) {
+    // Full-width fill (title bar, selection highlight) collapses to a
+    // single word-fill over the contiguous row span
+    if (x <= 0 && x + w >= OSD_WIDTH) {
+        int first = (y < 0) ? 0 : y;
+        int last = (y + h > OSD_HEIGHT) ? OSD_HEIGHT : y + h;
+        if (last <= first) return;
+        markDirtyRows(first, last - first);
+        memset(buffer + first * (OSD_WIDTH / 8), 0xFF,
+               (last - first) * (OSD_WIDTH / 8));
+        return;
+    }
+
     for (int row = y; row < y + h && row < OSD_HEIGHT; row++) {
         if (row < 0) continue;
         drawHLine(buffer, x, row, w);
@@ -474,6 +1038,9 @@ void OSDMenu::setVisible(bool show) {
     state.visible = show;
     if (show) {
         state.lastActivity = millis();
+        lastRenderValid = false;  // Force full redraw on next render
+    } else {
+        browserActive = false;    // Hiding the menu dismisses the browser
     }
 }
 
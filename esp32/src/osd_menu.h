@@ -11,6 +11,7 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "file_browser.h"
 
 // ============================================================================
 // Menu Item Types
@@ -46,6 +47,10 @@ struct MenuItem;  // Forward declaration
 
 typedef void (*MenuCallback)(MenuItem* item);
 
+// Invoked when the file browser commits a selection; path points into
+// the item's fileSelect.selectedPath buffer
+typedef void (*FileSelectedCallback)(MenuItem* item, const char* path);
+
 struct MenuItem {
     const char* label;          // Display text
     MenuItemType type;          // Item type
@@ -117,6 +122,27 @@ public:
      */
     void render(uint8_t* buffer);
 
+    /**
+     * @brief Render only changed content into buffer
+     *
+     * A selection move within the same menu level redraws just the two
+     * affected item rows; any structural change (menu level, scroll,
+     * visibility) falls back to a full render. Changed lines are tracked
+     * in a per-line dirty bitmap for partial SPI transmission.
+     *
+     * @param buffer Output buffer (OSD_BUFFER_SIZE bytes)
+     * @return true if any line changed and needs transmission
+     */
+    bool renderDirty(uint8_t* buffer);
+
+    /**
+     * @brief Get and clear the dirty line span from the last render
+     * @param lineStart First dirty OSD line
+     * @param numLines Number of dirty lines
+     * @return true if any lines were dirty
+     */
+    bool getDirtySpan(uint8_t& lineStart, uint8_t& numLines);
+
     /**
      * @brief Show/hide the menu
      * @param show true to show, false to hide
@@ -140,18 +166,127 @@ public:
      */
     MenuItem* getSelectedItem();
 
+    /**
+     * @brief Open the file browser view for a file-select item
+     *
+     * The browser renders FileBrowser entries through the windowed
+     * listing API (never the full listing), so directories of any size
+     * browse in constant memory. Activating a file writes the full
+     * path into the item's selectedPath buffer and fires the
+     * file-selected callback.
+     *
+     * @param item ITEM_FILE_SELECT item supplying filter and path buffer
+     */
+    void openBrowser(MenuItem* item);
+
+    /**
+     * @brief Check if the browser view is active
+     */
+    bool isBrowserActive() const { return browserActive; }
+
+    /**
+     * @brief Register the file-selected handler
+     */
+    void setFileSelectedCallback(FileSelectedCallback cb) {
+        fileSelectedCb = cb;
+    }
+
+    /**
+     * @brief Draw the transfer progress overlay
+     *
+     * Renders filename, progress bar, and throughput into the bottom
+     * two OSD lines of the buffer; the caller transmits just that
+     * region via the partial-line path.
+     *
+     * @param buffer Output buffer (OSD_BUFFER_SIZE bytes)
+     * @param name Filename being transferred
+     * @param percent Completion 0-100
+     * @param kbPerS Current throughput in KB/s
+     */
+    void renderTransferProgress(uint8_t* buffer, const char* name,
+                                uint8_t percent, uint32_t kbPerS);
+
 private:
     MenuState state;
-    uint8_t font8x8[96][8];  // Built-in 8x8 font (ASCII 32-127)
 
-    void initFont();
+    // Dirty-line tracking for partial updates
+    uint16_t dirtyLines;         // Bitmap, one bit per OSD line
+    MenuItem* lastMenu;          // Menu level at last render
+    uint8_t lastSelected;        // Selection at last render
+    uint8_t lastScroll;          // Scroll offset at last render
+    bool lastRenderValid;        // false forces full redraw
+    bool selectedRowDirty;       // Activation changed the selected row
+
+    // ------------------------------------------------------------------
+    // Text strip cache: each (text, inverted) pair is rasterized once
+    // into an 8-row 1-bpp strip on first use; later frames composite
+    // the strip with byte copies instead of re-walking the font table.
+    // Menu text is static string literals, so pointer identity is the
+    // cache key; toggle values are cached bracketed ("[Yes]") against
+    // the inner text pointer.
+    // ------------------------------------------------------------------
+    static const size_t STRIP_CACHE_SLOTS = 24;
+    static const size_t STRIP_MAX_BYTES = MAX_LABEL_LEN + 2;  // 1 byte/char
+
+    struct TextStrip {
+        const char* key;         // Source string pointer (literal)
+        bool invert;
+        bool bracketed;          // Rendered as "[key]"
+        uint8_t widthBytes;
+        uint32_t lastUsed;
+        uint8_t rows[8][STRIP_MAX_BYTES];
+    };
+
+    TextStrip strips[STRIP_CACHE_SLOTS];
+    uint32_t stripClock;
+
+    TextStrip* getStrip(const char* text, bool invert, bool bracketed);
+    void compositeStrip(uint8_t* buffer, int x, int y,
+                        const TextStrip* strip);
+    void drawCachedString(uint8_t* buffer, int x, int y, const char* text,
+                          bool invert, bool bracketed = false);
+
+    void markDirtyRows(int y, int h);
+    void drawItemRow(uint8_t* buffer, int itemIndex);
     void clearBuffer(uint8_t* buffer);
+    void clearRect(uint8_t* buffer, int x, int y, int w, int h);
     void drawChar(uint8_t* buffer, int x, int y, char c, bool invert);
     void drawString(uint8_t* buffer, int x, int y, const char* str, bool invert);
     void drawHLine(uint8_t* buffer, int x, int y, int width);
     void drawRect(uint8_t* buffer, int x, int y, int w, int h);
     void drawFilledRect(uint8_t* buffer, int x, int y, int w, int h);
 
+    // ------------------------------------------------------------------
+    // File browser view: a modal screen over the menu that lists
+    // FileBrowser entries. Only a WINDOW_CAPACITY slice of the listing
+    // is held locally; the window is re-anchored with a margin around
+    // the visible rows and prefetched after the frame is composed, so
+    // scroll steps never wait on the SD path before rendering.
+    // ------------------------------------------------------------------
+    bool browserActive;
+    MenuItem* browserItem;           // Item that opened the browser
+    FileSelectedCallback fileSelectedCb;
+    size_t browserSelected;          // Absolute filtered entry index
+    size_t browserScroll;            // First visible entry index
+    size_t browserTotal;             // Filtered entry count
+    FileEntry browserWindow[FileBrowser::WINDOW_CAPACITY];
+    size_t browserWindowOffset;      // Absolute index of window[0]
+    size_t browserWindowCount;
+    size_t lastBrowserSelected;      // Browser state at last render
+    size_t lastBrowserScroll;
+    bool browserViewValid;           // false forces full browser redraw
+
+    bool browserNavigate(NavCommand cmd);
+    void browserActivate();
+    void closeBrowser();
+    void resetBrowserListing();
+    void fetchBrowserWindow();
+    const FileEntry* browserEntryAt(size_t index);
+    void renderBrowser(uint8_t* buffer);
+    void renderBrowserDirty(uint8_t* buffer);
+    void scrollBrowserRows(int direction, uint8_t* buffer);
+    void drawBrowserRow(uint8_t* buffer, size_t absIndex);
+
     void enterSubmenu(uint8_t index);
     void exitSubmenu();
     void activateItem();
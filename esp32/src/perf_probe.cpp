@@ -0,0 +1,101 @@
+/**
+ * perf_probe.cpp - Cycle-accurate Hot-Path Instrumentation
+ *
+ * Accumulator update is branch-light integer math; everything with a
+ * cost (formatting, serial output) lives in dump(), which only runs on
+ * operator request.
+ */
+
+#include "perf_probe.h"
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <string.h>
+
+// Global instance
+PerfProbe perfProbe;
+
+// Slots are updated from both cores (render task vs transfer task) and
+// read by the serial dump path; the 64-bit sum would tear on 32-bit
+// Xtensa without this. The critical sections are a few instructions.
+static portMUX_TYPE s_statsMux = portMUX_INITIALIZER_UNLOCKED;
+
+static const char* kSlotNames[PERF_SLOT_COUNT] = {
+    "render",
+    "osd_send",
+    "chunk_send",
+    "tick",
+    "input_lat",
+};
+
+void PerfProbe::record(PerfSlot slot, uint32_t cycles) {
+    Stats& s = stats[slot];
+
+    // Log2 bucket: index of the highest set bit
+    uint32_t bucket = cycles ? (31 - __builtin_clz(cycles)) : 0;
+
+    portENTER_CRITICAL(&s_statsMux);
+    if (s.count == 0 || cycles < s.minCycles) {
+        s.minCycles = cycles;
+    }
+    if (cycles > s.maxCycles) {
+        s.maxCycles = cycles;
+    }
+    s.sum += cycles;
+    s.count++;
+    s.hist[bucket]++;
+    portEXIT_CRITICAL(&s_statsMux);
+}
+
+/**
+ * Approximate percentile from the log2 histogram: walk buckets until
+ * the cumulative count crosses the target, report that bucket's upper
+ * bound. Within a factor of two, which is enough to spot outliers.
+ */
+uint32_t PerfProbe::percentile(const Stats& s, uint8_t pct) {
+    if (s.count == 0) {
+        return 0;
+    }
+
+    uint64_t target = ((uint64_t)s.count * pct + 99) / 100;
+    uint64_t cumulative = 0;
+    for (int i = 0; i < PERF_HIST_BUCKETS; i++) {
+        cumulative += s.hist[i];
+        if (cumulative >= target) {
+            return (i >= 31) ? 0xFFFFFFFF : (2UL << i) - 1;
+        }
+    }
+    return s.maxCycles;
+}
+
+void PerfProbe::dump() {
+    uint32_t mhz = getCpuFrequencyMhz();
+    Serial.println("probe           count        min        avg        max       ~p99  (us)");
+
+    for (int i = 0; i < PERF_SLOT_COUNT; i++) {
+        // Snapshot under the mux; formatting and serial output must not
+        // run inside a critical section
+        portENTER_CRITICAL(&s_statsMux);
+        Stats s = stats[i];
+        portEXIT_CRITICAL(&s_statsMux);
+
+        uint32_t avg = s.count ? (uint32_t)(s.sum / s.count) : 0;
+        uint32_t p99 = percentile(s, 99);
+
+        Serial.printf("%-12s %8lu %10lu %10lu %10lu %10lu  %lu/%lu/%lu\n",
+                      kSlotNames[i],
+                      (unsigned long)s.count,
+                      (unsigned long)(s.count ? s.minCycles : 0),
+                      (unsigned long)avg,
+                      (unsigned long)s.maxCycles,
+                      (unsigned long)p99,
+                      (unsigned long)((s.count ? s.minCycles : 0) / mhz),
+                      (unsigned long)(avg / mhz),
+                      (unsigned long)(s.maxCycles / mhz));
+    }
+}
+
+void PerfProbe::reset() {
+    portENTER_CRITICAL(&s_statsMux);
+    memset(stats, 0, sizeof(stats));
+    portEXIT_CRITICAL(&s_statsMux);
+}
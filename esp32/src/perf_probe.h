@@ -0,0 +1,100 @@
+/**
+ * @file perf_probe.h
+ * @brief Cycle-accurate Hot-Path Instrumentation
+ *
+ * Named probes built on the Xtensa cycle counter. Each probe costs two
+ * counter reads and a handful of integer ops, cheap enough to leave in
+ * shipping builds around render, OSD transfer and file chunk paths.
+ * Distributions are tracked per slot as min/avg/max plus a log2
+ * histogram for an approximate p99, and dumped over serial on request.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <esp_idf_version.h>
+#include <esp_cpu.h>
+
+#if ESP_IDF_VERSION_MAJOR >= 5
+#define perfCycles()  esp_cpu_get_cycle_count()
+#else
+#define perfCycles()  esp_cpu_get_ccount()
+#endif
+
+// Fixed probe slots: one accumulator per instrumented path
+enum PerfSlot {
+    PERF_RENDER,        // OSDMenu render/renderDirty
+    PERF_OSD_SEND,      // OSD line/frame transfer
+    PERF_CHUNK_SEND,    // File transfer chunk (queue to ack)
+    PERF_TICK,          // Render task iteration
+    PERF_INPUT_LATENCY, // IRQ edge to menu navigation applied
+    PERF_SLOT_COUNT
+};
+
+// Log2 histogram buckets (covers 1 cycle .. 2^31 cycles)
+#define PERF_HIST_BUCKETS 32
+
+/**
+ * @class PerfProbe
+ * @brief Fixed-slot cycle counter accumulators with serial dump
+ */
+class PerfProbe {
+public:
+    /**
+     * @brief Record one sample into a slot
+     * @param slot Probe slot
+     * @param cycles Measured duration in CPU cycles
+     */
+    void record(PerfSlot slot, uint32_t cycles);
+
+    /**
+     * @brief Print a stats table for all slots (cold path, serial)
+     */
+    void dump();
+
+    /**
+     * @brief Reset all accumulators
+     */
+    void reset();
+
+private:
+    struct Stats {
+        uint32_t count;
+        uint64_t sum;
+        uint32_t minCycles;
+        uint32_t maxCycles;
+        uint32_t hist[PERF_HIST_BUCKETS];
+    };
+
+    Stats stats[PERF_SLOT_COUNT] = {};
+
+    uint32_t percentile(const Stats& s, uint8_t pct);
+};
+
+// Global instance
+extern PerfProbe perfProbe;
+
+/**
+ * @class PerfScope
+ * @brief RAII probe: records the enclosing scope's duration on exit
+ */
+class PerfScope {
+public:
+    explicit PerfScope(PerfSlot slot)
+        : m_slot(slot), m_start(perfCycles()) {}
+    ~PerfScope() {
+        perfProbe.record(m_slot, perfCycles() - m_start);
+    }
+
+private:
+    PerfSlot m_slot;
+    uint32_t m_start;
+};
+
+// Two-level indirection so __LINE__ expands before pasting; a direct
+// a##b would produce the literal identifier _perfScope__LINE__
+#define PERF_CONCAT2(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT2(a, b)
+
+#define PERF_SCOPE(slot) PerfScope PERF_CONCAT(_perfScope, __LINE__)(slot)
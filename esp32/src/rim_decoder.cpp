@@ -0,0 +1,41 @@
+/**
+ * rim_decoder.cpp - PDP-1 RIM Paper-Tape Decoder
+ *
+ * Strips read-in-mode framing from RIM tapes on the ESP32 so the FPGA
+ * loader receives a packed word stream instead of raw tape bytes.
+ */
+
+#include "rim_decoder.h"
+
+size_t RimDecoder::feed(const uint8_t* in, size_t len,
+                        uint8_t* out, size_t outCap) {
+    size_t written = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        uint8_t b = in[i];
+
+        if (!(b & 0x80)) {
+            // Leader/trailer: discard any partial word
+            acc = 0;
+            groups = 0;
+            continue;
+        }
+
+        acc = (acc << 6) | (b & 0x3F);
+        groups++;
+
+        if (groups == 3) {
+            // Complete 18-bit word: emit packed big-endian
+            if (written + 3 > outCap) {
+                break;
+            }
+            out[written++] = (acc >> 16) & 0x03;
+            out[written++] = (acc >> 8) & 0xFF;
+            out[written++] = acc & 0xFF;
+            acc = 0;
+            groups = 0;
+        }
+    }
+
+    return written;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Streaming decoder for PDP-1 RIM paper-tape framing.
+ *
+ * Tape convention (matches tools/rim2hex.py and the FPGA loader):
+ * bytes with bit 7 set carry 6 data bits each, three of them forming
+ * one 18-bit word; bytes without bit 7 are leader/trailer and are
+ * stripped, discarding any partial word in progress.
+ *
+ * Output is the packed word stream, 3 bytes per word, big-endian:
+ * byte 0 = word[17:16], byte 1 = word[15:8], byte 2 = word[7:0].
+ * The FPGA side just shifts bytes into a word register - no tape
+ * parsing left in hardware.
+ */
+struct RimDecoder {
+    uint32_t acc;       // Accumulated 6-bit groups
+    uint8_t groups;     // Groups collected toward the current word
+
+    void reset() {
+        acc = 0;
+        groups = 0;
+    }
+
+    /**
+     * @brief Decode a span of raw tape bytes
+     * @param in Raw tape bytes
+     * @param len Input length
+     * @param out Output buffer for packed words
+     * @param outCap Output capacity (worst case: len bytes)
+     * @return Bytes written to out
+     */
+    size_t feed(const uint8_t* in, size_t len, uint8_t* out, size_t outCap);
+};
+
+/** @brief Worst-case decoded size for a raw tape of rawLen bytes */
+inline size_t rimDecodedBound(size_t rawLen) {
+    // Every 3 input bytes can produce at most one 3-byte word
+    return rawLen;
+}
@@ -0,0 +1,171 @@
+/**
+ * ring_log.cpp - Non-blocking Ring-Buffer Logger
+ *
+ * Bounded MPSC ring (Vyukov sequence scheme): producers claim a slot
+ * with one atomic compare-exchange, format into it, and publish by
+ * bumping the slot sequence. The drain task is the only consumer and
+ * the only place that ever touches the UART.
+ */
+
+#include "ring_log.h"
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+// Global instance
+RingLog ringLog;
+
+// Drain task configuration: lowest priority that still empties the
+// ring between bursts
+#define DRAIN_TASK_STACK    2560
+#define DRAIN_TASK_PRIO     1
+#define DRAIN_IDLE_DELAY_MS 10
+
+void ringLogDrainTask(void* param) {
+    RingLog* log = (RingLog*)param;
+    while (true) {
+        log->drain();
+        vTaskDelay(pdMS_TO_TICKS(DRAIN_IDLE_DELAY_MS));
+    }
+}
+
+bool RingLog::init() {
+    if (running) {
+        return true;
+    }
+
+    for (uint32_t i = 0; i < RING_LOG_SLOTS; i++) {
+        slots[i].seq = i;
+    }
+    memset(tags, 0, sizeof(tags));
+    head = 0;
+    tail = 0;
+
+    TaskHandle_t task = nullptr;
+    xTaskCreatePinnedToCore(ringLogDrainTask, "log_drain",
+                            DRAIN_TASK_STACK, this,
+                            DRAIN_TASK_PRIO, &task, 0);
+    running = (task != nullptr);
+    return running;
+}
+
+/**
+ * Per-tag rate limiting. Returns true if the message should be
+ * dropped; suppressedOut carries the number of earlier drops to fold
+ * into the next message that passes.
+ */
+bool RingLog::rateLimit(const char* tag, uint16_t& suppressedOut) {
+    suppressedOut = 0;
+    uint32_t now = millis();
+
+    // Tags are string literals, so pointer identity is enough
+    TagState* state = nullptr;
+    for (size_t i = 0; i < RING_LOG_TAGS; i++) {
+        if (tags[i].tag == tag) {
+            state = &tags[i];
+            break;
+        }
+        if (!tags[i].tag) {
+            tags[i].tag = tag;
+            tags[i].lastMs = now - RING_LOG_TAG_RATE_MS;
+            state = &tags[i];
+            break;
+        }
+    }
+    if (!state) {
+        return false;  // Table full: log untracked rather than drop
+    }
+
+    if (now - state->lastMs < RING_LOG_TAG_RATE_MS) {
+        state->suppressed++;
+        dropped++;
+        return true;
+    }
+
+    state->lastMs = now;
+    suppressedOut = state->suppressed;
+    state->suppressed = 0;
+    return false;
+}
+
+void RingLog::write(const char* tag, const char* fmt, ...) {
+    if (!running) {
+        return;
+    }
+
+    uint16_t suppressed = 0;
+    if (rateLimit(tag, suppressed)) {
+        return;
+    }
+
+    // Claim a slot: the slot is free when its sequence equals the
+    // producer cursor position
+    uint32_t pos;
+    Slot* slot;
+    while (true) {
+        pos = head;
+        slot = &slots[pos & (RING_LOG_SLOTS - 1)];
+        uint32_t seq = slot->seq;
+        int32_t diff = (int32_t)(seq - pos);
+
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&head, &pos, pos + 1, false,
+                                            __ATOMIC_ACQ_REL,
+                                            __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Ring full: drop instead of blocking the hot path
+            dropped++;
+            return;
+        }
+        // Lost the race to another producer: retry
+    }
+
+    // Format in place; the UART cost is deferred to the drain task.
+    // snprintf returns the would-be length, not bytes written, so clamp
+    // after each call or a truncated message (long paths) would push
+    // the suffix write past the slot.
+    const int cap = sizeof(slot->msg) - 8;
+    int n = snprintf(slot->msg, cap, "[%s] ", tag);
+    if (n > cap - 1) {
+        n = cap - 1;
+    }
+    va_list args;
+    va_start(args, fmt);
+    n += vsnprintf(slot->msg + n, cap - n, fmt, args);
+    va_end(args);
+    if (n > cap - 1) {
+        n = cap - 1;
+    }
+
+    if (suppressed > 0) {
+        snprintf(slot->msg + n, 8, " (+%u)", (unsigned)(suppressed > 999
+                                                        ? 999 : suppressed));
+    }
+
+    // Publish: consumer sees the slot once seq == pos + 1
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+void RingLog::drain() {
+    while (true) {
+        uint32_t pos = tail;
+        Slot* slot = &slots[pos & (RING_LOG_SLOTS - 1)];
+        uint32_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+
+        if ((int32_t)(seq - (pos + 1)) < 0) {
+            return;  // Ring empty
+        }
+
+        Serial.println(slot->msg);
+
+        // Release the slot for the next lap of producers
+        __atomic_store_n(&slot->seq, pos + RING_LOG_SLOTS,
+                         __ATOMIC_RELEASE);
+        tail = pos + 1;
+    }
+}
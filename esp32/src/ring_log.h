@@ -0,0 +1,84 @@
+/**
+ * @file ring_log.h
+ * @brief Non-blocking Ring-Buffer Logger
+ *
+ * Hot paths must never wait on the UART: at 115200 baud one printf
+ * blocks the caller for milliseconds, mid-DMA-pipeline. Messages are
+ * formatted into a lock-free bounded ring and drained to the serial
+ * port by a low-priority background task. Per-tag rate limiting keeps
+ * a misbehaving path from flooding the ring; dropped messages are
+ * counted and reported with the next line that gets through.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Ring capacity (power of two) and per-message buffer size
+#define RING_LOG_SLOTS      32
+#define RING_LOG_MSG_LEN    96
+
+// Minimum interval between messages with the same tag; faster arrivals
+// are dropped (and counted) instead of queued
+#define RING_LOG_TAG_RATE_MS  50
+
+// Tracked tags for rate limiting
+#define RING_LOG_TAGS       8
+
+/**
+ * @class RingLog
+ * @brief Bounded MPSC log ring with background serial drain
+ *
+ * Producers (any task) reserve a slot with an atomic sequence
+ * exchange, format in place and publish; the drain task is the single
+ * consumer. A full ring drops the message rather than blocking.
+ */
+class RingLog {
+public:
+    /**
+     * @brief Allocate the ring and start the drain task
+     * @return true if the drain task was created
+     */
+    bool init();
+
+    /**
+     * @brief Queue a printf-style message (never blocks on the UART)
+     * @param tag Short subsystem tag, must be a string literal
+     * @param fmt printf format string
+     */
+    void write(const char* tag, const char* fmt, ...)
+        __attribute__((format(printf, 3, 4)));
+
+    /**
+     * @brief Total messages dropped (ring full or rate limited)
+     */
+    uint32_t getDropped() const { return dropped; }
+
+private:
+    struct Slot {
+        volatile uint32_t seq;         // Vyukov-style sequence number
+        char msg[RING_LOG_MSG_LEN];
+    };
+
+    struct TagState {
+        const char* tag;
+        uint32_t lastMs;
+        uint16_t suppressed;
+    };
+
+    Slot slots[RING_LOG_SLOTS];
+    volatile uint32_t head = 0;        // Producer cursor
+    volatile uint32_t tail = 0;        // Consumer cursor (drain task only)
+    TagState tags[RING_LOG_TAGS];
+    volatile uint32_t dropped = 0;
+    bool running = false;
+
+    bool rateLimit(const char* tag, uint16_t& suppressedOut);
+    void drain();
+
+    friend void ringLogDrainTask(void* param);
+};
+
+// Global logger instance
+extern RingLog ringLog;
@@ -0,0 +1,145 @@
+/**
+ * settings.cpp - NVS-backed Persistent Settings
+ *
+ * Restores menu toggles at boot and writes changes back in coalesced
+ * batches. The FPGA sees every change immediately through the status
+ * shadow; only the flash write is deferred.
+ */
+
+#include "settings.h"
+#include "spi_fpga.h"
+#include <Arduino.h>
+#include <nvs.h>
+#include <string.h>
+
+// Global instance
+SettingsStore settingsStore;
+
+// NVS namespace for all OSD controller settings
+#define SETTINGS_NAMESPACE "pdp1osd"
+
+// Autoboot image keys (path + FILE_TYPE_* index)
+#define KEY_LAST_IMAGE       "lastimg"
+#define KEY_LAST_IMAGE_TYPE  "lastimgt"
+
+void SettingsStore::registerBool(const char* key, bool* value,
+                                 uint8_t statusBit) {
+    if (count >= SETTINGS_MAX) {
+        Serial.printf("Settings registry full, dropping '%s'\n", key);
+        return;
+    }
+    entries[count].key = key;
+    entries[count].value = value;
+    entries[count].statusBit = statusBit;
+    entries[count].shadow = *value;
+    count++;
+}
+
+bool SettingsStore::init() {
+    // The Arduino core has already initialized the NVS partition
+    esp_err_t err = nvs_open(SETTINGS_NAMESPACE, NVS_READWRITE, &nvsHandle);
+    if (err != ESP_OK) {
+        Serial.printf("NVS open failed (%d), settings are volatile\n", err);
+        return false;
+    }
+    opened = true;
+
+    // Restore registered settings; absent keys keep their defaults
+    for (size_t i = 0; i < count; i++) {
+        uint8_t stored = 0;
+        if (nvs_get_u8(nvsHandle, entries[i].key, &stored) == ESP_OK) {
+            *entries[i].value = (stored != 0);
+        }
+        entries[i].shadow = *entries[i].value;
+    }
+
+    Serial.printf("Settings restored (%u entries)\n", (unsigned)count);
+    return true;
+}
+
+uint32_t SettingsStore::buildStatusWord() {
+    uint32_t status = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (*entries[i].value) {
+            status |= (1UL << entries[i].statusBit);
+        }
+    }
+    return status;
+}
+
+void SettingsStore::applyToFpga() {
+    spiFpga.setStatus(buildStatusWord());
+}
+
+void SettingsStore::update() {
+    // Detect flips made through the menu toggles
+    bool changed = false;
+    for (size_t i = 0; i < count; i++) {
+        if (*entries[i].value != entries[i].shadow) {
+            entries[i].shadow = *entries[i].value;
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        // FPGA sees the change on the next input-frame flush; only the
+        // flash write is deferred
+        applyToFpga();
+        dirty = true;
+        lastChangeMs = millis();
+    }
+
+    // Coalesced commit: one NVS write batch per quiet period, no
+    // matter how many toggles were flipped
+    if (dirty && opened &&
+        millis() - lastChangeMs >= SETTINGS_COMMIT_DELAY_MS) {
+        for (size_t i = 0; i < count; i++) {
+            nvs_set_u8(nvsHandle, entries[i].key,
+                       *entries[i].value ? 1 : 0);
+        }
+        nvs_commit(nvsHandle);
+        dirty = false;
+        Serial.println("Settings committed to NVS");
+    }
+}
+
+void SettingsStore::saveLastImage(const char* path, uint8_t fileType) {
+    if (!opened || !path) {
+        return;
+    }
+
+    // Autoboot reloads the same image every power cycle; skip the
+    // flash write when nothing changed
+    char stored[128] = "";
+    size_t len = sizeof(stored);
+    uint8_t storedType = 0xFF;
+    nvs_get_str(nvsHandle, KEY_LAST_IMAGE, stored, &len);
+    nvs_get_u8(nvsHandle, KEY_LAST_IMAGE_TYPE, &storedType);
+    if (strcmp(stored, path) == 0 && storedType == fileType) {
+        return;
+    }
+
+    nvs_set_str(nvsHandle, KEY_LAST_IMAGE, path);
+    nvs_set_u8(nvsHandle, KEY_LAST_IMAGE_TYPE, fileType);
+    nvs_commit(nvsHandle);
+}
+
+bool SettingsStore::getLastImage(char* path, size_t pathSize,
+                                 uint8_t* fileType) {
+    if (!opened) {
+        return false;
+    }
+
+    size_t len = pathSize;
+    if (nvs_get_str(nvsHandle, KEY_LAST_IMAGE, path, &len) != ESP_OK) {
+        return false;
+    }
+
+    uint8_t t = 0;
+    if (nvs_get_u8(nvsHandle, KEY_LAST_IMAGE_TYPE, &t) != ESP_OK) {
+        return false;
+    }
+
+    *fileType = t;
+    return path[0] != '\0';
+}
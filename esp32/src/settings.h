@@ -0,0 +1,104 @@
+/**
+ * @file settings.h
+ * @brief NVS-backed Persistent Settings
+ *
+ * Persists the menu toggles across power cycles and maps them onto the
+ * FPGA core status word. NVS writes are coalesced: flips are committed
+ * in one batch after the user stops changing things, so scrolling
+ * through options never wears flash or stalls the render tick.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <nvs.h>
+
+// Commit pending flips to NVS once no setting has changed for this long
+#define SETTINGS_COMMIT_DELAY_MS  2000
+
+// Maximum number of registered settings
+#define SETTINGS_MAX              8
+
+/**
+ * @class SettingsStore
+ * @brief Registry of boolean settings with batched NVS persistence
+ *
+ * Settings remain plain bools owned by the application (the menu
+ * toggles point at them directly); the store polls for flips from the
+ * render tick via update().
+ */
+class SettingsStore {
+public:
+    /**
+     * @brief Register a setting before init()
+     * @param key NVS key (also used for logging)
+     * @param value Application-owned bool the menu toggle points at
+     * @param statusBit Bit position in the core status word
+     */
+    void registerBool(const char* key, bool* value, uint8_t statusBit);
+
+    /**
+     * @brief Open NVS and restore all registered settings
+     *
+     * Values missing from NVS keep their compile-time defaults.
+     *
+     * @return true if the NVS namespace was opened
+     */
+    bool init();
+
+    /**
+     * @brief Build the combined core status word from current values
+     * @return Status word with one bit per registered setting
+     */
+    uint32_t buildStatusWord();
+
+    /**
+     * @brief Push the combined status word to the FPGA shadow
+     *
+     * One setStatus() covers every setting; the boot path calls this
+     * once so startup-to-configured is a single SPI transaction.
+     */
+    void applyToFpga();
+
+    /**
+     * @brief Poll for flips and run the coalesced commit
+     *
+     * Call once per render tick. A flip updates the FPGA status shadow
+     * immediately; the NVS commit happens once, after
+     * SETTINGS_COMMIT_DELAY_MS of quiet.
+     */
+    void update();
+
+    /**
+     * @brief Persist the last successfully loaded image for autoboot
+     *
+     * Committed immediately (not coalesced): loads are rare and the
+     * write is skipped when the stored value already matches.
+     */
+    void saveLastImage(const char* path, uint8_t fileType);
+
+    /**
+     * @brief Read the autoboot image stored by saveLastImage()
+     * @return true if a path was stored
+     */
+    bool getLastImage(char* path, size_t pathSize, uint8_t* fileType);
+
+private:
+    struct Entry {
+        const char* key;
+        bool* value;
+        uint8_t statusBit;
+        bool shadow;        // Last value seen by update()
+    };
+
+    Entry entries[SETTINGS_MAX];
+    size_t count = 0;
+    nvs_handle_t nvsHandle = 0;
+    bool opened = false;
+    bool dirty = false;         // Flips awaiting NVS commit
+    uint32_t lastChangeMs = 0;
+};
+
+// Global settings store instance
+extern SettingsStore settingsStore;
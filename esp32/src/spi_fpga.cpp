@@ -8,12 +8,17 @@
 
 #include "spi_fpga.h"
 #include "config.h"
+#include "ring_log.h"
+#include "perf_probe.h"
 
 #include <driver/spi_master.h>
 #include <driver/gpio.h>
 #include <esp_log.h>
+#include <esp_heap_caps.h>
+#include <soc/soc_memory_layout.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <freertos/semphr.h>
 #include <string.h>
 
 static const char* TAG = "SPI_FPGA";
@@ -22,12 +27,110 @@ static const char* TAG = "SPI_FPGA";
 // SPI Handle and DMA Buffer
 // ============================================================================
 
-static spi_device_handle_t s_spiHandle = nullptr;
+static spi_device_handle_t s_spiHandle = nullptr;   // Control traffic
+static spi_device_handle_t s_bulkHandle = nullptr;  // Bulk (trained clock)
 static uint8_t* s_dmaBuffer = nullptr;
+static uint8_t* s_frameBuffer = nullptr;
 
 // DMA-capable buffer size (must be 32-bit aligned)
 #define DMA_BUFFER_SIZE  512
 
+// ============================================================================
+// Bus Arbitration
+// ============================================================================
+// The render task (OSD, input) and the transfer task (file chunks) both
+// drive the bus, and manual CS framing means their sessions must never
+// interleave mid-transaction. A recursive mutex serializes them at
+// transaction granularity; bulk callers additionally yield while a
+// control or OSD caller is waiting, so menu traffic slots in between
+// chunks instead of queueing behind a whole transfer.
+// ============================================================================
+
+static SemaphoreHandle_t s_busMutex = nullptr;
+static volatile uint8_t s_priorityWaiters = 0;
+// Guards the waiter count across cores
+static portMUX_TYPE s_waiterMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ============================================================================
+// Link Training
+// ============================================================================
+// Control bytes always run at SPI_CLOCK_HZ (chosen for the worst wiring
+// seen in the field). Bulk transfers get their own device handle whose
+// clock is trained at init: each candidate is probed with a LINK_ECHO
+// pattern and the highest error-free clock wins. CLK/MOSI/MISO are on
+// IOMUX pins, so the full ladder is reachable.
+// ============================================================================
+
+static const int kClockLadder[] = {
+    10000000, 16000000, 20000000, 26666666, 40000000
+};
+#define CLOCK_LADDER_LEN (sizeof(kClockLadder) / sizeof(kClockLadder[0]))
+
+// Echo rounds per candidate; all must pass error-free
+#define LINK_TRAIN_ROUNDS  4
+
+// ============================================================================
+// Asynchronous Transaction Ring
+// ============================================================================
+// Each slot frames a complete command (cmd byte + payload) into one DMA
+// transaction. Chip select is toggled from the driver's pre/post ISR
+// callbacks so queued transactions need no CPU involvement in flight.
+// ============================================================================
+
+// Slot payload must hold one framed OSD line (cmd + OSD_LINE_BYTES)
+#define ASYNC_SLOT_SIZE  (OSD_LINE_BYTES + 4)
+
+struct AsyncSlot {
+    spi_transaction_t trans;
+    SpiCompletionCallback callback;
+    void* callbackArg;
+    bool inUse;
+    uint8_t* buffer;  // DMA-capable, ASYNC_SLOT_SIZE bytes
+};
+
+static AsyncSlot s_asyncSlots[SPI_ASYNC_DEPTH];
+static volatile uint8_t s_asyncPending = 0;
+
+// ============================================================================
+// Command Batch Buffers
+// ============================================================================
+// One tick's small commands (input frame, dirty OSD lines) are packed
+// back-to-back into a single framed transaction and shipped under one
+// chip select, so the per-command session cost (CS edges plus polling
+// transmit setup) is paid once per tick. Two buffers alternate so the
+// next tick can build while the previous batch is still on the wire.
+// Sized for the worst partial update: every OSD line plus headroom for
+// the input frame and a few control commands.
+// ============================================================================
+
+#define BATCH_BUFFER_SIZE  ((OSD_LINE_BYTES + 1) * OSD_LINES + 16)
+
+struct BatchBuffer {
+    uint8_t* data;           // DMA-capable, BATCH_BUFFER_SIZE bytes
+    volatile bool inFlight;  // Cleared by the completion callback
+};
+
+static BatchBuffer s_batchBuffers[2];
+static int s_batchCurrent = 0;
+
+static void batchCompleteCb(void* arg) {
+    ((BatchBuffer*)arg)->inFlight = false;
+}
+
+// Pre/post transfer callbacks (ISR context): async transactions carry
+// their slot in trans->user and get per-transaction CS framing.
+static void IRAM_ATTR spiPreTransferCb(spi_transaction_t* trans) {
+    if (trans->user) {
+        gpio_set_level((gpio_num_t)PIN_SPI_CS, 0);
+    }
+}
+
+static void IRAM_ATTR spiPostTransferCb(spi_transaction_t* trans) {
+    if (trans->user) {
+        gpio_set_level((gpio_num_t)PIN_SPI_CS, 1);
+    }
+}
+
 // Global instance
 SPIFpga spiFpga;
 
@@ -43,6 +146,12 @@ bool SPIFpga::init() {
 
     ESP_LOGI(TAG, "Initializing SPI FPGA driver");
 
+    s_busMutex = xSemaphoreCreateRecursiveMutex();
+    if (!s_busMutex) {
+        ESP_LOGE(TAG, "Failed to create bus mutex");
+        return false;
+    }
+
     // Configure GPIO pins for handshaking
     gpio_config_t io_conf = {};
 
@@ -77,7 +186,10 @@ bool SPIFpga::init() {
     busConfig.sclk_io_num = PIN_SPI_CLK;
     busConfig.quadwp_io_num = -1;
     busConfig.quadhd_io_num = -1;
-    busConfig.max_transfer_sz = DMA_BUFFER_SIZE;
+    // Largest single transaction: a full command batch (every OSD line
+    // framed, plus headroom), which exceeds both the bare OSD frame and
+    // a framed file chunk
+    busConfig.max_transfer_sz = BATCH_BUFFER_SIZE;
     busConfig.flags = SPICOMMON_BUSFLAG_MASTER;
 
     esp_err_t ret = spi_bus_initialize(SPI2_HOST, &busConfig, SPI_DMA_CH_AUTO);
@@ -91,8 +203,10 @@ bool SPIFpga::init() {
     devConfig.clock_speed_hz = SPI_CLOCK_HZ;
     devConfig.mode = 0;  // CPOL=0, CPHA=0
     devConfig.spics_io_num = -1;  // Manual CS control
-    devConfig.queue_size = 4;
+    devConfig.queue_size = SPI_ASYNC_DEPTH;
     devConfig.flags = 0;
+    devConfig.pre_cb = spiPreTransferCb;
+    devConfig.post_cb = spiPostTransferCb;
 
     ret = spi_bus_add_device(SPI2_HOST, &devConfig, &s_spiHandle);
     if (ret != ESP_OK) {
@@ -101,21 +215,133 @@ bool SPIFpga::init() {
         return false;
     }
 
-    // Allocate DMA-capable buffer
+    // Allocate DMA-capable buffers (chunk staging + full OSD frame)
     s_dmaBuffer = (uint8_t*)heap_caps_malloc(DMA_BUFFER_SIZE, MALLOC_CAP_DMA);
-    if (!s_dmaBuffer) {
-        ESP_LOGE(TAG, "Failed to allocate DMA buffer");
+    s_frameBuffer = (uint8_t*)heap_caps_malloc(OSD_BUFFER_SIZE, MALLOC_CAP_DMA);
+    if (!s_dmaBuffer || !s_frameBuffer) {
+        ESP_LOGE(TAG, "Failed to allocate DMA buffers");
+        heap_caps_free(s_dmaBuffer);
+        heap_caps_free(s_frameBuffer);
+        s_dmaBuffer = nullptr;
+        s_frameBuffer = nullptr;
         spi_bus_remove_device(s_spiHandle);
         spi_bus_free(SPI2_HOST);
         return false;
     }
 
+    // Allocate async transaction slots
+    for (int i = 0; i < SPI_ASYNC_DEPTH; i++) {
+        s_asyncSlots[i].buffer =
+            (uint8_t*)heap_caps_malloc(ASYNC_SLOT_SIZE, MALLOC_CAP_DMA);
+        s_asyncSlots[i].inUse = false;
+        if (!s_asyncSlots[i].buffer) {
+            ESP_LOGE(TAG, "Failed to allocate async slot %d", i);
+            return false;
+        }
+    }
+
+    // Allocate the alternating command batch buffers
+    for (int i = 0; i < 2; i++) {
+        s_batchBuffers[i].data =
+            (uint8_t*)heap_caps_malloc(BATCH_BUFFER_SIZE, MALLOC_CAP_DMA);
+        s_batchBuffers[i].inFlight = false;
+        if (!s_batchBuffers[i].data) {
+            ESP_LOGE(TAG, "Failed to allocate batch buffer %d", i);
+            return false;
+        }
+    }
+
+    // Train the bulk clock and add the second device handle for it;
+    // control traffic stays on the conservative clock
+    int bulkClock = trainLinkSpeed();
+    devConfig.clock_speed_hz = bulkClock;
+    ret = spi_bus_add_device(SPI2_HOST, &devConfig, &s_bulkHandle);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Bulk device add failed, sharing control device");
+        s_bulkHandle = s_spiHandle;
+    }
+
     m_initialized = true;
-    ESP_LOGI(TAG, "SPI FPGA driver initialized (CLK=%d Hz)", SPI_CLOCK_HZ);
+    ESP_LOGI(TAG, "SPI FPGA driver initialized (control=%d Hz, bulk=%d Hz)",
+             SPI_CLOCK_HZ, bulkClock);
 
     return true;
 }
 
+bool SPIFpga::probeEcho(int clockHz) {
+    spi_device_interface_config_t devConfig = {};
+    devConfig.clock_speed_hz = clockHz;
+    devConfig.mode = 0;
+    devConfig.spics_io_num = -1;  // Manual CS, same as the main devices
+    devConfig.queue_size = 1;
+
+    spi_device_handle_t probe = nullptr;
+    if (spi_bus_add_device(SPI2_HOST, &devConfig, &probe) != ESP_OK) {
+        return false;
+    }
+
+    // Pattern stresses the link: solid levels, alternating bits,
+    // walking ones and single-zero bytes
+    static const uint8_t kPattern[] = {
+        0x00, 0xFF, 0xAA, 0x55, 0x0F, 0xF0, 0xC3, 0x3C,
+        0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+        0xFE, 0xFD, 0xFB, 0xF7, 0xEF, 0xDF, 0xBF, 0x7F,
+        0xA5, 0x5A, 0x96, 0x69, 0x33, 0xCC, 0x18, 0xE7
+    };
+    const size_t patternLen = sizeof(kPattern);
+
+    bool pass = true;
+    for (int round = 0; round < LINK_TRAIN_ROUNDS && pass; round++) {
+        // Frame: LINK_ECHO + pattern; the FPGA mirrors each MOSI byte
+        // back on MISO one byte later
+        s_frameBuffer[0] = LINK_ECHO;
+        memcpy(s_frameBuffer + 1, kPattern, patternLen);
+
+        spi_transaction_t trans = {};
+        trans.length = (patternLen + 1) * 8;
+        trans.tx_buffer = s_frameBuffer;
+        trans.rx_buffer = s_dmaBuffer;
+
+        assertCS();
+        esp_err_t ret = spi_device_polling_transmit(probe, &trans);
+        deassertCS();
+
+        if (ret != ESP_OK) {
+            pass = false;
+            break;
+        }
+
+        // Skip the pipeline fill bytes, then every received byte must
+        // equal the MOSI byte sent one slot earlier
+        for (size_t i = 2; i <= patternLen; i++) {
+            if (s_dmaBuffer[i] != s_frameBuffer[i - 1]) {
+                pass = false;
+                break;
+            }
+        }
+    }
+
+    spi_bus_remove_device(probe);
+    return pass;
+}
+
+int SPIFpga::trainLinkSpeed() {
+    int best = SPI_CLOCK_HZ;
+
+    for (size_t i = 0; i < CLOCK_LADDER_LEN; i++) {
+        if (probeEcho(kClockLadder[i])) {
+            best = kClockLadder[i];
+        } else {
+            // First failing rung ends the climb; everything above it
+            // would be even worse
+            break;
+        }
+    }
+
+    ESP_LOGI(TAG, "Link training settled on %d Hz", best);
+    return best;
+}
+
 // ============================================================================
 // Low-level SPI Operations
 // ============================================================================
@@ -128,6 +354,38 @@ void SPIFpga::deassertCS() {
     gpio_set_level((gpio_num_t)PIN_SPI_CS, 1);
 }
 
+void SPIFpga::lockBus(uint8_t trafficClass) {
+    if (!s_busMutex) {
+        return;  // Pre-init (link training runs before m_initialized)
+    }
+
+    if (trafficClass == SPI_TC_BULK) {
+        // Let waiting interactive traffic through first; one tick of
+        // delay per check keeps this from busy-spinning
+        while (s_priorityWaiters > 0) {
+            vTaskDelay(1);
+        }
+        xSemaphoreTakeRecursive(s_busMutex, portMAX_DELAY);
+        return;
+    }
+
+    portENTER_CRITICAL(&s_waiterMux);
+    s_priorityWaiters++;
+    portEXIT_CRITICAL(&s_waiterMux);
+
+    xSemaphoreTakeRecursive(s_busMutex, portMAX_DELAY);
+
+    portENTER_CRITICAL(&s_waiterMux);
+    s_priorityWaiters--;
+    portEXIT_CRITICAL(&s_waiterMux);
+}
+
+void SPIFpga::unlockBus() {
+    if (s_busMutex) {
+        xSemaphoreGiveRecursive(s_busMutex);
+    }
+}
+
 bool SPIFpga::waitReady() {
     // Signal ESP ready
     gpio_set_level((gpio_num_t)PIN_ESP_READY, 1);
@@ -155,6 +413,40 @@ bool SPIFpga::hasIrq() {
     return gpio_get_level((gpio_num_t)PIN_OSD_IRQ) == 1;
 }
 
+uint8_t SPIFpga::readTransferStatus() {
+    if (!m_initialized) {
+        return 0x00;
+    }
+
+    lockBus(SPI_TC_CONTROL);
+    waitAsyncIdle();
+
+    assertCS();
+    transfer(FILE_TX_ACK);
+    uint8_t status = transfer(0x00);
+    deassertCS();
+    unlockBus();
+
+    return status;
+}
+
+uint8_t SPIFpga::readInput() {
+    if (!m_initialized) {
+        return 0x00;
+    }
+
+    lockBus(SPI_TC_CONTROL);
+    waitAsyncIdle();
+
+    assertCS();
+    transfer(INPUT_READ);
+    uint8_t input = transfer(0x00);
+    deassertCS();
+    unlockBus();
+
+    return input;
+}
+
 uint8_t SPIFpga::transfer(uint8_t data) {
     spi_transaction_t trans = {};
     trans.length = 8;
@@ -171,10 +463,40 @@ uint8_t SPIFpga::transfer(uint8_t data) {
     return s_dmaBuffer[0];
 }
 
+uint8_t* SPIFpga::acquireDmaBuffer(size_t size) {
+    uint8_t* buffer = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_DMA);
+    if (!buffer) {
+        ESP_LOGE(TAG, "DMA buffer allocation failed (%u bytes)",
+                 (unsigned)size);
+    }
+    return buffer;
+}
+
+void SPIFpga::releaseDmaBuffer(uint8_t* buffer) {
+    heap_caps_free(buffer);
+}
+
 void SPIFpga::transferBuffer(const uint8_t* txBuf, uint8_t* rxBuf, size_t len) {
     if (len == 0) return;
 
-    // Process in chunks that fit in DMA buffer
+    // Zero-copy fast path: a DMA-capable source (e.g. from
+    // acquireDmaBuffer) goes to the peripheral directly, whatever its
+    // size, with no staging and no chunking
+    if (txBuf && !rxBuf && esp_ptr_dma_capable(txBuf)) {
+        spi_transaction_t trans = {};
+        trans.length = len * 8;
+        trans.tx_buffer = txBuf;
+
+        esp_err_t ret = spi_device_polling_transmit(s_spiHandle, &trans);
+        if (ret != ESP_OK) {
+            ringLog.write(TAG, "SPI buffer transfer failed: %s",
+                          esp_err_to_name(ret));
+        }
+        return;
+    }
+
+    // Staging path for non-DMA memory (flash constants, stack buffers):
+    // process in chunks that fit the staging buffer
     size_t offset = 0;
     while (offset < len) {
         size_t chunkLen = (len - offset > DMA_BUFFER_SIZE) ? DMA_BUFFER_SIZE : (len - offset);
@@ -194,7 +516,8 @@ void SPIFpga::transferBuffer(const uint8_t* txBuf, uint8_t* rxBuf, size_t len) {
 
         esp_err_t ret = spi_device_polling_transmit(s_spiHandle, &trans);
         if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "SPI buffer transfer failed: %s", esp_err_to_name(ret));
+            ringLog.write(TAG, "SPI buffer transfer failed: %s",
+                          esp_err_to_name(ret));
             return;
         }
 
@@ -216,6 +539,10 @@ void SPIFpga::sendCommand(uint8_t cmd, const uint8_t* data, size_t len) {
         return;
     }
 
+    // Synchronous path must not interleave with queued transactions
+    lockBus(SPI_TC_CONTROL);
+    waitAsyncIdle();
+
     assertCS();
 
     // Send command byte
@@ -227,6 +554,148 @@ void SPIFpga::sendCommand(uint8_t cmd, const uint8_t* data, size_t len) {
     }
 
     deassertCS();
+    unlockBus();
+}
+
+// ============================================================================
+// Asynchronous Command Interface
+// ============================================================================
+
+// Reap one completed transaction; returns false if none completed
+static bool reapOneAsync(TickType_t timeout) {
+    spi_transaction_t* done = nullptr;
+    esp_err_t ret = spi_device_get_trans_result(s_bulkHandle, &done, timeout);
+    if (ret != ESP_OK) {
+        return false;
+    }
+
+    AsyncSlot* slot = (AsyncSlot*)done->user;
+    if (slot) {
+        if (slot->callback) {
+            slot->callback(slot->callbackArg);
+        }
+        slot->inUse = false;
+    }
+    s_asyncPending--;
+    return true;
+}
+
+// Find a free transaction slot, reaping completed ones if needed
+static AsyncSlot* acquireSlot() {
+    while (true) {
+        for (int i = 0; i < SPI_ASYNC_DEPTH; i++) {
+            if (!s_asyncSlots[i].inUse) {
+                return &s_asyncSlots[i];
+            }
+        }
+        // Ring full: block until one transaction completes
+        if (!reapOneAsync(portMAX_DELAY)) {
+            return nullptr;
+        }
+    }
+}
+
+bool SPIFpga::sendCommandAsync(uint8_t cmd, const uint8_t* data, size_t len,
+                               SpiCompletionCallback callback, void* arg) {
+    if (!m_initialized || len + 1 > ASYNC_SLOT_SIZE) {
+        ESP_LOGE(TAG, "Invalid async command (len=%u)", (unsigned)len);
+        return false;
+    }
+
+    lockBus(SPI_TC_OSD);
+
+    AsyncSlot* slot = acquireSlot();
+    if (!slot) {
+        unlockBus();
+        return false;
+    }
+
+    // Frame command byte + payload into the slot buffer
+    slot->buffer[0] = cmd;
+    if (data && len > 0) {
+        memcpy(slot->buffer + 1, data, len);
+    }
+
+    memset(&slot->trans, 0, sizeof(slot->trans));
+    slot->trans.length = (len + 1) * 8;
+    slot->trans.tx_buffer = slot->buffer;
+    slot->trans.user = slot;
+    slot->callback = callback;
+    slot->callbackArg = arg;
+    slot->inUse = true;
+
+    esp_err_t ret = spi_device_queue_trans(s_bulkHandle, &slot->trans, portMAX_DELAY);
+    if (ret != ESP_OK) {
+        ringLog.write(TAG, "Failed to queue transaction: %s",
+                      esp_err_to_name(ret));
+        slot->inUse = false;
+        unlockBus();
+        return false;
+    }
+
+    s_asyncPending++;
+    unlockBus();
+    return true;
+}
+
+bool SPIFpga::queueTransaction(const uint8_t* dmaData, size_t len,
+                               SpiCompletionCallback callback, void* arg,
+                               uint8_t trafficClass) {
+    if (!m_initialized || !dmaData || len == 0) {
+        ESP_LOGE(TAG, "Invalid queued transaction");
+        return false;
+    }
+
+    lockBus(trafficClass);
+
+    AsyncSlot* slot = acquireSlot();
+    if (!slot) {
+        unlockBus();
+        return false;
+    }
+
+    // Caller's buffer goes straight to the DMA engine, no staging copy
+    memset(&slot->trans, 0, sizeof(slot->trans));
+    slot->trans.length = len * 8;
+    slot->trans.tx_buffer = dmaData;
+    slot->trans.user = slot;
+    slot->callback = callback;
+    slot->callbackArg = arg;
+    slot->inUse = true;
+
+    esp_err_t ret = spi_device_queue_trans(s_bulkHandle, &slot->trans, portMAX_DELAY);
+    if (ret != ESP_OK) {
+        ringLog.write(TAG, "Failed to queue transaction: %s",
+                      esp_err_to_name(ret));
+        slot->inUse = false;
+        unlockBus();
+        return false;
+    }
+
+    s_asyncPending++;
+    unlockBus();
+    return true;
+}
+
+void SPIFpga::pollAsync() {
+    if (s_asyncPending == 0) {
+        return;
+    }
+    lockBus(SPI_TC_CONTROL);
+    while (s_asyncPending > 0 && reapOneAsync(0)) {
+    }
+    unlockBus();
+}
+
+void SPIFpga::waitAsyncIdle() {
+    if (s_asyncPending == 0) {
+        return;
+    }
+    lockBus(SPI_TC_CONTROL);
+    while (s_asyncPending > 0) {
+        reapOneAsync(portMAX_DELAY);
+    }
+    unlockBus();
 }
 
 // ============================================================================
@@ -239,17 +708,22 @@ void SPIFpga::setOsdEnable(bool enable) {
 }
 
 void SPIFpga::sendOsdBuffer(const uint8_t* buffer, size_t lineStart, size_t numLines) {
+    PERF_SCOPE(PERF_OSD_SEND);
+
     if (!m_initialized || !buffer) {
         ESP_LOGE(TAG, "Invalid state or buffer");
         return;
     }
 
-    // Calculate bytes per line (OSD_WIDTH / 8 for 1-bit pixels)
-    const size_t bytesPerLine = OSD_WIDTH / 8;  // 32 bytes per line
+    lockBus(SPI_TC_OSD);
+    waitAsyncIdle();
+
+    // One OSD line = OSD_LINE_HEIGHT pixel rows (256 bytes)
+    const size_t bytesPerLine = OSD_LINE_BYTES;
 
     for (size_t i = 0; i < numLines; i++) {
         size_t lineNum = lineStart + i;
-        if (lineNum >= (OSD_HEIGHT)) {
+        if (lineNum >= OSD_LINES) {
             break;
         }
 
@@ -276,6 +750,53 @@ void SPIFpga::sendOsdBuffer(const uint8_t* buffer, size_t lineStart, size_t numL
         // Small delay between lines for FPGA processing
         taskYIELD();
     }
+
+    unlockBus();
+}
+
+void SPIFpga::sendOsdFrame(const uint8_t* frame) {
+    PERF_SCOPE(PERF_OSD_SEND);
+
+    if (!m_initialized || !frame) {
+        ESP_LOGE(TAG, "Invalid state or buffer");
+        return;
+    }
+
+    lockBus(SPI_TC_OSD);
+    waitAsyncIdle();
+
+    // Stage the frame in DMA-capable memory
+    // Zero-copy when the caller's frame is DMA-capable (the main OSD
+    // framebuffer is acquired through acquireDmaBuffer); the staging
+    // copy only remains for non-DMA sources
+    const uint8_t* src = frame;
+    if (!esp_ptr_dma_capable(frame)) {
+        memcpy(s_frameBuffer, frame, OSD_BUFFER_SIZE);
+        src = s_frameBuffer;
+    }
+
+    assertCS();
+
+    // Line 0 write command; FPGA address auto-increments through the frame
+    transfer(OSD_CMD_WRITE);
+
+    // Ship the whole 256x128 bitmap as one queued DMA transaction
+    spi_transaction_t trans = {};
+    trans.length = OSD_BUFFER_SIZE * 8;
+    trans.tx_buffer = src;
+
+    esp_err_t ret = spi_device_queue_trans(s_bulkHandle, &trans, portMAX_DELAY);
+    if (ret == ESP_OK) {
+        spi_transaction_t* done = nullptr;
+        ret = spi_device_get_trans_result(s_bulkHandle, &done, portMAX_DELAY);
+    }
+    if (ret != ESP_OK) {
+        ringLog.write(TAG, "OSD frame transfer failed: %s",
+                      esp_err_to_name(ret));
+    }
+
+    deassertCS();
+    unlockBus();
 }
 
 // ============================================================================
@@ -283,73 +804,136 @@ void SPIFpga::sendOsdBuffer(const uint8_t* buffer, size_t lineStart, size_t numL
 // ============================================================================
 
 void SPIFpga::setStatus(uint32_t status) {
-    uint8_t data[4];
-    data[0] = (status >> 0) & 0xFF;
-    data[1] = (status >> 8) & 0xFF;
-    data[2] = (status >> 16) & 0xFF;
-    data[3] = (status >> 24) & 0xFF;
-
-    sendCommand(STATUS_SET, data, 4);
-    ESP_LOGD(TAG, "Status set: 0x%08lX", (unsigned long)status);
+    if (m_status != status) {
+        m_status = status;
+        m_inputDirty = true;
+    }
 }
 
 void SPIFpga::setJoystick(uint8_t player, uint16_t state) {
-    uint8_t data[2];
-    data[0] = state & 0xFF;
-    data[1] = (state >> 8) & 0xFF;
+    if (player > 1) {
+        return;
+    }
+    if (m_joyState[player] != state) {
+        m_joyState[player] = state;
+        m_inputDirty = true;
+    }
+}
 
-    uint8_t cmd = (player == 0) ? JOYSTICK_0 : JOYSTICK_1;
-    sendCommand(cmd, data, 2);
+bool SPIFpga::flushInputFrame() {
+    if (!m_inputDirty) {
+        return false;
+    }
+
+    // One transaction carries everything the core polls per tick:
+    // joy0, joy1 (16-bit LE each) and the status register (32-bit LE)
+    uint8_t frame[8];
+    frame[0] = m_joyState[0] & 0xFF;
+    frame[1] = (m_joyState[0] >> 8) & 0xFF;
+    frame[2] = m_joyState[1] & 0xFF;
+    frame[3] = (m_joyState[1] >> 8) & 0xFF;
+    frame[4] = (m_status >> 0) & 0xFF;
+    frame[5] = (m_status >> 8) & 0xFF;
+    frame[6] = (m_status >> 16) & 0xFF;
+    frame[7] = (m_status >> 24) & 0xFF;
+
+    // Joins the open batch when one exists; immediate cycle otherwise
+    batchCommand(INPUT_FRAME, frame, sizeof(frame));
+    m_inputDirty = false;
+
+    ESP_LOGD(TAG, "Input frame: joy0=%04X joy1=%04X status=%08lX",
+             m_joyState[0], m_joyState[1], (unsigned long)m_status);
+    return true;
 }
 
 // ============================================================================
-// File Transfer
+// Command Batching
 // ============================================================================
 
-void SPIFpga::startFileTransfer(uint8_t index) {
-    if (m_transferActive) {
-        ESP_LOGW(TAG, "Transfer already active, ending previous");
-        endFileTransfer();
+bool SPIFpga::batchBegin() {
+    if (!m_initialized) {
+        return false;
+    }
+
+    // Rotate to the other buffer. The previous tick's batch is normally
+    // long done by now, but never hand the DMA engine a buffer we are
+    // about to scribble over.
+    pollAsync();
+    int next = s_batchCurrent ^ 1;
+    while (s_batchBuffers[next].inFlight) {
+        waitAsyncIdle();
     }
 
-    ESP_LOGI(TAG, "Starting file transfer, index=%d", index);
+    s_batchCurrent = next;
+    m_batchLen = 0;
+    m_batchActive = true;
+    return true;
+}
 
-    // Set file index
-    uint8_t idxData = index;
-    sendCommand(FILE_INDEX, &idxData, 1);
+bool SPIFpga::batchCommand(uint8_t cmd, const uint8_t* data, size_t len) {
+    if (!m_batchActive) {
+        // No batch open (boot-time callers, off-tick paths): pay the
+        // immediate command cycle instead
+        sendCommand(cmd, data, len);
+        return m_initialized;
+    }
 
-    // Begin transfer
-    assertCS();
-    transfer(FILE_TX);
-    transfer(0x01);  // Transfer start flag
+    if (m_batchLen + 1 + len > BATCH_BUFFER_SIZE) {
+        // Oversized tick: ship what we have and keep packing into a
+        // fresh buffer. Sized as it is, this should never trigger.
+        batchFlush();
+        batchBegin();
+    }
 
-    m_transferActive = true;
+    uint8_t* dst = s_batchBuffers[s_batchCurrent].data + m_batchLen;
+    dst[0] = cmd;
+    if (data && len > 0) {
+        memcpy(dst + 1, data, len);
+    }
+    m_batchLen += 1 + len;
+    return true;
 }
 
-void SPIFpga::sendFileData(uint8_t byte) {
-    if (!m_transferActive) {
-        ESP_LOGE(TAG, "No active transfer");
-        return;
+bool SPIFpga::batchOsdLines(const uint8_t* buffer, size_t lineStart,
+                            size_t numLines) {
+    if (!buffer) {
+        return false;
     }
 
-    // Send data command with byte
-    transfer(FILE_TX_DAT);
-    transfer(byte);
+    for (size_t i = 0; i < numLines; i++) {
+        size_t lineNum = lineStart + i;
+        if (lineNum >= OSD_LINES) {
+            break;
+        }
+
+        uint8_t lineCmd = OSD_CMD_WRITE | (lineNum & 0x0F);
+        const uint8_t* lineData = buffer + (lineNum * OSD_LINE_BYTES);
+
+        if (!batchCommand(lineCmd, lineData, OSD_LINE_BYTES)) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
-void SPIFpga::endFileTransfer() {
-    if (!m_transferActive) {
-        return;
+bool SPIFpga::batchFlush() {
+    if (!m_batchActive) {
+        return false;
     }
+    m_batchActive = false;
 
-    // End transfer sequence
-    transfer(FILE_TX);
-    transfer(0x00);  // Transfer end flag
-    deassertCS();
+    if (m_batchLen == 0) {
+        return false;
+    }
 
-    // Clear ready signal
-    gpio_set_level((gpio_num_t)PIN_ESP_READY, 0);
+    BatchBuffer* batch = &s_batchBuffers[s_batchCurrent];
+    batch->inFlight = true;
+    if (!queueTransaction(batch->data, m_batchLen,
+                          batchCompleteCb, batch, SPI_TC_OSD)) {
+        batch->inFlight = false;
+        return false;
+    }
 
-    m_transferActive = false;
-    ESP_LOGI(TAG, "File transfer complete");
+    return true;
 }
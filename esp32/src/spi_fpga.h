@@ -24,11 +24,19 @@
 #define STATUS_SET       0x1E    // Set core status bits
 #define JOYSTICK_0       0x02    // Player 1 joystick state
 #define JOYSTICK_1       0x03    // Player 2 joystick state
+#define INPUT_FRAME      0x04    // Combined joystick + status frame
+#define INPUT_READ       0x10    // Read navigation input byte
+#define LINK_ECHO        0x12    // Echo test: FPGA mirrors MOSI on MISO
 
 // File Transfer Commands
 #define FILE_TX          0x53    // Start file transfer
 #define FILE_TX_DAT      0x54    // File data byte
 #define FILE_INDEX       0x55    // Set file slot index
+#define FILE_TX_ACK      0x56    // Read transfer flow-control status
+
+// FILE_TX_ACK status bits (returned on MISO)
+#define FPGA_STATUS_READY  0x01  // FPGA can accept the next chunk
+#define FPGA_STATUS_ERROR  0x80  // FPGA rejected the last chunk
 
 // ============================================================================
 // Transfer Configuration
@@ -36,6 +44,23 @@
 
 #define SPI_CHUNK_SIZE   256    // OSD buffer chunk size in bytes
 #define SPI_TIMEOUT_MS   100    // Command timeout in milliseconds
+#define SPI_ASYNC_DEPTH  4      // Queued transaction ring depth
+
+// ============================================================================
+// Traffic Classes
+// ============================================================================
+// The driver arbitrates the bus between tasks at transaction
+// granularity. Bulk traffic (file chunks) yields to waiting control and
+// OSD traffic, so menu updates stay responsive during a transfer
+// instead of queueing behind every chunk.
+// ============================================================================
+
+#define SPI_TC_CONTROL   0      // Commands, input reads (highest)
+#define SPI_TC_OSD       1      // OSD line batches and frames
+#define SPI_TC_BULK      2      // File transfer chunks (yields)
+
+// Completion callback for asynchronous transactions
+typedef void (*SpiCompletionCallback)(void* arg);
 
 // ============================================================================
 // SPIFpga Class
@@ -46,7 +71,10 @@
  * @brief SPI master driver for FPGA communication
  *
  * Implements MiSTer-compatible protocol with handshaking support.
- * Uses ESP-IDF SPI master driver for hardware acceleration.
+ * Uses ESP-IDF SPI master driver for hardware acceleration. A single
+ * instance carries all FPGA traffic; a recursive bus mutex with
+ * traffic-class priorities arbitrates between tasks at transaction
+ * granularity.
  */
 class SPIFpga {
 public:
@@ -72,6 +100,92 @@ public:
      */
     void sendOsdBuffer(const uint8_t* buffer, size_t lineStart, size_t numLines);
 
+    /**
+     * @brief Queue command asynchronously without blocking the caller
+     *
+     * The command byte and payload are framed into one DMA transaction
+     * (chip select handled in the driver ISR callbacks) and queued; the
+     * CPU is free to render or read SD while the transfer is in flight.
+     * Call pollAsync() periodically or waitAsyncIdle() before any
+     * synchronous operation.
+     *
+     * @param cmd Command byte
+     * @param data Optional data payload
+     * @param len Payload length (must fit one transaction slot)
+     * @param callback Optional completion callback
+     * @param arg Argument passed to callback
+     * @return true if the transaction was queued
+     */
+    bool sendCommandAsync(uint8_t cmd, const uint8_t* data = nullptr,
+                          size_t len = 0,
+                          SpiCompletionCallback callback = nullptr,
+                          void* arg = nullptr);
+
+    /**
+     * @brief Allocate a DMA-capable buffer for zero-copy transfers
+     *
+     * Buffers acquired here can be handed to queueTransaction() /
+     * sendOsdFrame() directly with no staging copy inside the driver.
+     * Long-lived workloads (the OSD framebuffer, transfer chunk
+     * buffers) should allocate once at startup and keep the buffer.
+     *
+     * @param size Buffer size in bytes
+     * @return DMA-capable buffer, or nullptr if internal RAM is exhausted
+     */
+    uint8_t* acquireDmaBuffer(size_t size);
+
+    /**
+     * @brief Free a buffer obtained from acquireDmaBuffer()
+     *
+     * The buffer must not be part of any in-flight transaction.
+     *
+     * @param buffer Buffer to free (nullptr is ignored)
+     */
+    void releaseDmaBuffer(uint8_t* buffer);
+
+    /**
+     * @brief Queue a pre-framed transaction from a caller-owned buffer
+     *
+     * The buffer must be DMA-capable, already contain the command byte
+     * and payload, and stay valid until the transaction completes. Used
+     * by bulk paths (file streaming) that manage their own buffers and
+     * cannot afford a staging copy per chunk.
+     *
+     * @param dmaData DMA-capable framed buffer (cmd byte + payload)
+     * @param len Total framed length in bytes
+     * @param callback Optional completion callback
+     * @param arg Argument passed to callback
+     * @param trafficClass SPI_TC_* arbitration class (defaults to bulk)
+     * @return true if the transaction was queued
+     */
+    bool queueTransaction(const uint8_t* dmaData, size_t len,
+                          SpiCompletionCallback callback = nullptr,
+                          void* arg = nullptr,
+                          uint8_t trafficClass = SPI_TC_BULK);
+
+    /**
+     * @brief Reap completed asynchronous transactions (non-blocking)
+     *
+     * Invokes completion callbacks and recycles transaction slots.
+     */
+    void pollAsync();
+
+    /**
+     * @brief Block until all queued transactions have completed
+     */
+    void waitAsyncIdle();
+
+    /**
+     * @brief Upload complete OSD frame as a single DMA transaction
+     *
+     * Sends OSD_CMD_WRITE for line 0 followed by the full OSD_BUFFER_SIZE
+     * bitmap; the FPGA write address auto-increments through the frame.
+     * Roughly 4x faster than per-byte transfers at the same clock.
+     *
+     * @param frame Pointer to full OSD frame (OSD_BUFFER_SIZE bytes)
+     */
+    void sendOsdFrame(const uint8_t* frame);
+
     /**
      * @brief Enable or disable OSD overlay
      * @param enable true to show OSD, false to hide
@@ -79,34 +193,83 @@ public:
     void setOsdEnable(bool enable);
 
     /**
-     * @brief Set FPGA core status register
+     * @brief Set FPGA core status register (shadowed)
+     *
+     * Updates the local shadow only; the value reaches the FPGA in the
+     * next flushInputFrame() on the sender task's tick.
+     *
      * @param status 32-bit status value
      */
     void setStatus(uint32_t status);
 
     /**
-     * @brief Update joystick state for player
+     * @brief Update joystick state for player (shadowed)
      * @param player Player index (0 or 1)
      * @param state 16-bit joystick button/direction state
      */
     void setJoystick(uint8_t player, uint16_t state);
 
     /**
-     * @brief Begin file transfer to specified slot
-     * @param index File slot index
+     * @brief Send the combined input frame if anything changed
+     *
+     * Both joystick words and the status register travel in one
+     * INPUT_FRAME transaction instead of three separate command
+     * cycles. Unchanged frames are skipped entirely, so calling this
+     * every tick costs nothing while the controls are idle. With a
+     * batch open the frame joins it instead of paying its own cycle.
+     *
+     * @return true if a frame was sent, false if skipped as unchanged
      */
-    void startFileTransfer(uint8_t index);
+    bool flushInputFrame();
 
     /**
-     * @brief Send single byte during file transfer
-     * @param byte Data byte to transfer
+     * @brief Open a command batch for this tick
+     *
+     * Commands appended while a batch is open are packed back-to-back
+     * into one framed DMA transaction and shipped under a single chip
+     * select by batchFlush(), so the fixed per-command session cost is
+     * paid once per tick. Every batchable command carries a fixed
+     * payload length, which is how the FPGA decoder delimits commands
+     * inside the shared select window.
+     *
+     * @return true if a batch buffer is available
      */
-    void sendFileData(uint8_t byte);
+    bool batchBegin();
 
     /**
-     * @brief Complete file transfer and release bus
+     * @brief Append one command to the open batch
+     *
+     * Falls back to an immediate sendCommand() cycle when no batch is
+     * open, so callers need not care whether they run inside a tick.
+     *
+     * @param cmd Command byte
+     * @param data Optional payload
+     * @param len Payload length
+     * @return true if the command was accepted
+     */
+    bool batchCommand(uint8_t cmd, const uint8_t* data = nullptr,
+                      size_t len = 0);
+
+    /**
+     * @brief Append OSD line writes to the open batch
+     * @param buffer Pointer to OSD pixel buffer
+     * @param lineStart First line to append
+     * @param numLines Number of lines to append
+     * @return true if all lines were accepted
+     */
+    bool batchOsdLines(const uint8_t* buffer, size_t lineStart,
+                       size_t numLines);
+
+    /**
+     * @brief Queue the open batch as one asynchronous DMA transaction
+     *
+     * An empty batch costs nothing. The transaction completes in the
+     * background; batchBegin() rotates buffers so the next tick can
+     * build while this one is still on the wire.
+     *
+     * @return true if a non-empty batch was queued
      */
-    void endFileTransfer();
+    bool batchFlush();
 
     /**
      * @brief Check if FPGA is ready for commands
@@ -120,6 +283,18 @@ public:
      */
     bool hasIrq();
 
+    /**
+     * @brief Read pending navigation input byte from FPGA
+     * @return Raw input code, 0x00 if none
+     */
+    uint8_t readInput();
+
+    /**
+     * @brief Read transfer flow-control status byte from FPGA
+     * @return FPGA_STATUS_* bits
+     */
+    uint8_t readTransferStatus();
+
 private:
     /**
      * @brief Assert chip select (active low)
@@ -137,6 +312,24 @@ private:
      */
     bool waitReady();
 
+    /**
+     * @brief Probe the link upward and pick the bulk transfer clock
+     *
+     * Runs the LINK_ECHO pattern test at each candidate clock, keeping
+     * the highest one that echoes every round error-free. Control
+     * traffic stays at the conservative SPI_CLOCK_HZ regardless.
+     *
+     * @return Highest error-free clock in Hz (SPI_CLOCK_HZ if none pass)
+     */
+    int trainLinkSpeed();
+
+    /**
+     * @brief Run one echo round at the given clock
+     * @param clockHz Candidate clock to probe
+     * @return true if every echoed byte matched the pattern
+     */
+    bool probeEcho(int clockHz);
+
     /**
      * @brief Transfer single byte over SPI
      * @param data Byte to transmit
@@ -152,8 +345,34 @@ private:
      */
     void transferBuffer(const uint8_t* txBuf, uint8_t* rxBuf, size_t len);
 
+    /**
+     * @brief Take the bus mutex, honoring traffic-class priority
+     *
+     * Bulk callers spin-yield while a control or OSD caller is waiting,
+     * so interactive traffic slots in between chunk transactions. The
+     * mutex is recursive: driver internals that nest (batchFlush via
+     * queueTransaction, sendCommand via waitAsyncIdle) lock safely.
+     *
+     * @param trafficClass SPI_TC_* class of the caller
+     */
+    void lockBus(uint8_t trafficClass);
+
+    /**
+     * @brief Release the bus mutex
+     */
+    void unlockBus();
+
     bool m_initialized = false;
-    bool m_transferActive = false;
+
+    // Input-frame shadow state: written by set*(), shipped by
+    // flushInputFrame() only when a field actually changed
+    uint16_t m_joyState[2] = {0, 0};
+    uint32_t m_status = 0;
+    bool m_inputDirty = false;
+
+    // Command batch under construction (buffers live in the .cpp)
+    size_t m_batchLen = 0;
+    bool m_batchActive = false;
 };
 
 // Global SPI FPGA instance